@@ -0,0 +1,74 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include "CPU.hpp"
+
+#if defined(FAKE8080_DISPATCH_COMPUTED_GOTO)
+static constexpr const char* Backend_Name{ "computed goto" };
+#elif defined(FAKE8080_DISPATCH_TAIL_CALL)
+static constexpr const char* Backend_Name{ "tail calls" };
+#elif defined(FAKE8080_DISPATCH_DECODE_CACHE)
+static constexpr const char* Backend_Name{ "caché de decodificación" };
+#elif defined(FAKE8080_JIT)
+static constexpr const char* Backend_Name{ "JIT x86-64" };
+#elif defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+static constexpr const char* Backend_Name{ "bloques básicos" };
+#elif defined(FAKE8080_DISPATCH_AOT)
+static constexpr const char* Backend_Name{ "AOT" };
+#else
+static constexpr const char* Backend_Name{ "tabla" };
+#endif
+
+#if defined(FAKE8080_DISPATCH_AOT)
+// Generado por fake8080_aot a partir de bench/Workload.rom
+extern const AotProgram workload_program;
+#endif
+
+static constexpr uint64_t Emulated_Cycles{ 500'000'000 };
+
+// Bucle sintético con la mezcla típica de un ROM: movimientos, ALU, memoria, stack y saltos.
+// bench/Workload.rom contiene los mismos bytes para el backend AOT
+static constexpr std::array<uint8_t, 32> Workload{
+    0x31, 0x00, 0xF0,   // 0000: LXI SP, 0xF000
+    0x26, 0x20,         // 0003: MVI H, 0x20
+    0x7E,               // 0005: MOV A, M
+    0x80,               // 0006: ADD B
+    0x77,               // 0007: MOV M, A
+    0x2C,               // 0008: INR L
+    0x04,               // 0009: INR B
+    0x4F,               // 000A: MOV C, A
+    0xA9,               // 000B: XRA C
+    0x1B,               // 000C: DCX D
+    0xC5,               // 000D: PUSH B
+    0xD1,               // 000E: POP D
+    0xE6, 0x3F,         // 000F: ANI 0x3F
+    0xFE, 0x10,         // 0011: CPI 0x10
+    0xEB,               // 0013: XCHG
+    0xEB,               // 0014: XCHG
+    0xCD, 0x1B, 0x00,   // 0015: CALL 0x001B
+    0xC3, 0x03, 0x00,   // 0018: JMP 0x0003
+    0xC9,               // 001B: RET
+};
+
+int main() {
+    std::array<uint8_t, 0x10000> memory{};
+    std::copy(Workload.begin(), Workload.end(), memory.begin());
+
+    CPU cpu;
+    cpu.setROM(memory);
+
+#if defined(FAKE8080_DISPATCH_AOT)
+    cpu.setProgram(workload_program);
+#endif
+
+    const auto start{ std::chrono::steady_clock::now() };
+    const auto executedCycles{ cpu.run(Emulated_Cycles) };
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+    std::printf("Despacho: %s\n", Backend_Name);
+    std::printf("Flags: %s\n", Lazy_Flags_Enabled ? "perezosas" : "inmediatas");
+    std::printf("Ciclos emulados: %llu\n", static_cast<unsigned long long>(executedCycles));
+    std::printf("Tiempo: %.3f s\n", elapsed.count());
+    std::printf("Velocidad: %.1f MHz emulados\n", executedCycles / elapsed.count() / 1e6);
+}
@@ -0,0 +1,49 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include "Registers.hpp"
+
+static constexpr uint64_t Iterations{ 200'000'000 };
+
+/// @brief Impide que el compilador elimine o pliegue los accesos del bucle
+/// @param registers Registros usados en el bucle
+static void clobber(Registers& registers) noexcept {
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(&registers) : "memory");
+#else
+    static_cast<void>(registers);
+#endif
+}
+
+// Accesos de los handlers más frecuentes: INX H, MOV A,M (lee HL), ADD B, XCHG, PUSH/POP PSW y un CMC
+int main() {
+    Registers registers;
+
+    const auto start{ std::chrono::steady_clock::now() };
+
+    for (uint64_t i{ 0 }; i < Iterations; ++i) {
+        registers.setCombinedRegister(Registers::CombinedRegister::HL, registers.getCombinedRegister(Registers::CombinedRegister::HL) + 1);
+
+        const auto address{ registers.getCombinedRegister(Registers::CombinedRegister::HL) };
+        registers.setRegister(Registers::Register::A, static_cast<uint8_t>(address) + registers.getRegister(Registers::Register::B));
+
+        const auto de{ registers.getCombinedRegister(Registers::CombinedRegister::DE) };
+        registers.setCombinedRegister(Registers::CombinedRegister::DE, registers.getCombinedRegister(Registers::CombinedRegister::HL));
+        registers.setCombinedRegister(Registers::CombinedRegister::HL, de);
+
+        const auto psw{ registers.getCombinedRegister(Registers::CombinedRegister::PSW) };
+        registers.setCombinedRegister(Registers::CombinedRegister::PSW, psw);
+
+        registers.setFlag(Registers::Flags::CY, !registers.getFlag(Registers::Flags::CY));
+
+        clobber(registers);
+    }
+
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+    std::printf("Flags: %s\n", Lazy_Flags_Enabled ? "perezosas" : "inmediatas");
+    std::printf("Iteraciones: %llu\n", static_cast<unsigned long long>(Iterations));
+    std::printf("Tiempo: %.3f s\n", elapsed.count());
+    std::printf("Por iteración: %.2f ns\n", elapsed.count() * 1e9 / Iterations);
+    std::printf("HL final: %04X\n", registers.getCombinedRegister(Registers::CombinedRegister::HL));
+}
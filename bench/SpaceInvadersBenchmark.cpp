@@ -0,0 +1,63 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <string_view>
+#include "SpaceInvadersMachine.hpp"
+
+static constexpr uint64_t Default_Frames{ 36'000 };
+
+// Frames emulados por segundo de la placa de Space Invaders, sin límite de velocidad ni vídeo
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Uso: %s <directorio con invaders.h, .g, .f y .e> [frames]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::string directory{ argv[1] };
+    const uint64_t frames{ argc > 2 ? std::strtoull(argv[2], nullptr, 10) : Default_Frames };
+
+    std::array<std::string, SpaceInvadersMachine::Rom_Names.size()> paths;
+    std::array<std::string_view, SpaceInvadersMachine::Rom_Names.size()> pathViews;
+
+    for (size_t i{ 0 }; i < paths.size(); ++i) {
+        paths[i] = directory + "/" + std::string{ SpaceInvadersMachine::Rom_Names[i] };
+        pathViews[i] = paths[i];
+    }
+
+    try {
+        SpaceInvadersMachine machine{ pathViews };
+
+        // Como en la recreativa, una moneda y el botón de un jugador para que el juego salga del modo demo
+        machine.runFrame();
+        machine.setInput(SpaceInvadersMachine::Input::Coin, true);
+
+        const auto start{ std::chrono::steady_clock::now() };
+
+        for (uint64_t frame{ 0 }; frame < frames; ++frame) {
+            if (frame == 30) {
+                machine.setInput(SpaceInvadersMachine::Input::Coin, false);
+                machine.setInput(SpaceInvadersMachine::Input::Player1Start, true);
+            }
+            else if (frame == 60) {
+                machine.setInput(SpaceInvadersMachine::Input::Player1Start, false);
+            }
+
+            machine.runFrame();
+        }
+
+        const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+        const auto framesPerSecond{ frames / elapsed.count() };
+
+        std::printf("Frames: %llu\n", static_cast<unsigned long long>(frames));
+        std::printf("Tiempo: %.3f s\n", elapsed.count());
+        std::printf("Velocidad: %.1f frames/s (%.1fx la recreativa)\n", framesPerSecond, framesPerSecond / SpaceInvadersMachine::Frames_Per_Second);
+    }
+    catch (const std::exception& error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,32 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "Fake8080.hpp"
+
+static constexpr size_t Instances{ 1000 };
+
+// Arranque de una granja de instancias sobre la misma ROM: la primera proyecta el fichero y el resto la comparte
+int main() {
+    std::vector<std::unique_ptr<Fake8080>> instances;
+    instances.reserve(Instances);
+
+    const auto start{ std::chrono::steady_clock::now() };
+    instances.push_back(std::make_unique<Fake8080>(FAKE8080_BENCH_ROM));
+    const auto firstReady{ std::chrono::steady_clock::now() };
+
+    while (instances.size() < Instances) {
+        instances.push_back(std::make_unique<Fake8080>(FAKE8080_BENCH_ROM));
+    }
+
+    const auto end{ std::chrono::steady_clock::now() };
+
+    const std::chrono::duration<double> first{ firstReady - start };
+    const std::chrono::duration<double> rest{ end - firstReady };
+
+    std::printf("Imagen: %s\n", RomImage::open(FAKE8080_BENCH_ROM)->isMapped() ? "proyectada (mmap)" : "leída por bloques");
+    std::printf("Instancias: %zu\n", Instances);
+    std::printf("Primera instancia: %.2f us\n", first.count() * 1e6);
+    std::printf("Por instancia con la ROM compartida: %.2f us\n", rest.count() * 1e6 / (Instances - 1));
+}
@@ -0,0 +1,78 @@
+#ifndef AOT_COMPILER_HEADER
+#define AOT_COMPILER_HEADER
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/// @brief Recompilador estático: recorre el código alcanzable de una ROM y lo traduce a una unidad de C++
+///
+/// Cada bloque básico se convierte en una función que llama a los handlers plantilla de la CPU con el opcode
+/// como constante. Los saltos indirectos (RET, PCHL) y el código fuera de la imagen o modificado en ejecución
+/// no se traducen, la CPU los ejecuta con el intérprete.
+class AotCompiler {
+public:
+    /// @brief Instrucción de un bloque
+    struct Instruction {
+        uint16_t address{ 0 };
+        uint8_t opcode{ 0 };
+
+        /// @brief Ciclos acumulados del bloque hasta esta instrucción incluida
+        uint32_t cyclesUntil{ 0 };
+    };
+
+    /// @brief Bloque básico recuperado del flujo de control
+    struct Block {
+        uint16_t start{ 0 };
+        uint32_t end{ 0 };
+
+        /// @brief Ciclos de todas las instrucciones menos la última
+        uint32_t bodyCycles{ 0 };
+
+        std::vector<Instruction> instructions;
+
+        /// @brief Destinos conocidos: saltos y llamadas directas, vectores de RST y la instrucción siguiente
+        std::vector<uint16_t> successors;
+
+        /// @brief Indica si la última instrucción es una transferencia de control
+        bool terminated{ false };
+    };
+
+    /// @param rom Imagen de la ROM, la dirección 0 corresponde a su primer byte
+    explicit AotCompiler(std::span<const uint8_t> rom);
+
+    /// @brief Recorre el código alcanzable desde los puntos de entrada y construye sus bloques
+    /// @param entryPoints Direcciones de inicio, normalmente el reset y los vectores de interrupción
+    void analyze(std::span<const uint16_t> entryPoints);
+
+    /// @brief Escribe la unidad de C++ con una función por bloque y el AotProgram que las agrupa
+    /// @param output Destino del código
+    /// @param symbol Nombre de la variable AotProgram generada
+    void emit(std::ostream& output, std::string_view symbol) const;
+
+    [[nodiscard]]
+    const std::map<uint16_t, Block>& blocks() const noexcept;
+
+    /// @brief Indica si una instrucción puede escribir en memoria sin terminar el bloque
+    /// @param opcode Opcode a evaluar
+    /// @return true si el bloque debe comprobar después si ha modificado código
+    [[nodiscard]]
+    static bool writesMemory(uint8_t opcode) noexcept;
+
+private:
+    std::span<const uint8_t> rom_m;
+    std::map<uint16_t, Block> blocks_m;
+
+    /// @brief Traduce el bloque que empieza en una dirección
+    /// @param start Dirección de inicio, dentro de la imagen
+    /// @return Bloque, vacío si la primera instrucción no cabe en la imagen
+    [[nodiscard]]
+    Block translate(uint16_t start) const;
+
+    void emitBlock(std::ostream& output, const Block& block) const;
+};
+
+#endif // !AOT_COMPILER_HEADER
@@ -0,0 +1,53 @@
+#ifndef AOT_PROGRAM_HEADER
+#define AOT_PROGRAM_HEADER
+
+#include <cstdint>
+#include <span>
+
+class CPU;
+
+/// @brief ROM traducida a C++ por fake8080_aot, con una función por bloque básico alcanzable
+struct AotProgram {
+    /// @brief Ejecuta un bloque completo y deja el pc en la siguiente instrucción
+    /// @return Ciclos usados
+    using Function = uint32_t(*)(CPU& cpu);
+
+    /// @brief Bloque traducido
+    struct Block {
+        uint16_t start;
+        uint32_t end;
+
+        /// @brief Ciclos de todas las instrucciones menos la última
+        uint32_t bodyCycles;
+
+        /// @brief Alguna instrucción antes de la última accede a memoria de datos, que puede caer en una página de E/S
+        bool accessesMemory;
+
+        Function function;
+    };
+
+    /// @brief Bloques ordenados por dirección de inicio
+    std::span<const Block> blocks;
+
+    /// @brief Tamaño y hash de la imagen traducida, para comprobar que coincide con la ROM cargada
+    uint32_t romSize;
+    uint64_t romHash;
+
+    /// @brief Hash FNV-1a de 64 bits
+    /// @param data Bytes a procesar
+    /// @return Hash de los bytes
+    [[nodiscard]]
+    static constexpr uint64_t hash(std::span<const uint8_t> data) noexcept;
+};
+
+constexpr uint64_t AotProgram::hash(std::span<const uint8_t> data) noexcept {
+    uint64_t result{ 0xCBF29CE484222325 };
+
+    for (const auto byte : data) {
+        result = (result ^ byte) * 0x100000001B3;
+    }
+
+    return result;
+}
+
+#endif // !AOT_PROGRAM_HEADER
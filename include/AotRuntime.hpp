@@ -0,0 +1,36 @@
+#ifndef AOT_RUNTIME_HEADER
+#define AOT_RUNTIME_HEADER
+
+#include <cstdint>
+#include "CPU.hpp"
+#include "AotProgram.hpp"
+
+#if !defined(FAKE8080_DISPATCH_AOT)
+#error "El código generado por fake8080_aot necesita el backend AOT"
+#endif
+
+/// @brief Acceso del código generado por fake8080_aot a los handlers de la CPU
+///
+/// Cada instrucción se traduce a una llamada con el opcode como constante, así el compilador puede expandir
+/// los handlers y optimizar entre instrucciones consecutivas del mismo bloque.
+struct AotRuntime {
+    /// @brief Ejecuta el handler de un opcode
+    /// @tparam Opcode Opcode a ejecutar
+    /// @return Número de ciclos usados
+    template<uint8_t Opcode>
+    static uint8_t execute(CPU& cpu) {
+        return cpu.execute<Opcode>();
+    }
+
+    static void setPC(CPU& cpu, uint16_t pc) noexcept {
+        cpu.pc_m = pc;
+    }
+
+    /// @brief Indica si una escritura ha modificado código traducido y el bloque debe terminar
+    [[nodiscard]]
+    static bool codeModified(const CPU& cpu) noexcept {
+        return cpu.codeModified_m;
+    }
+};
+
+#endif // !AOT_RUNTIME_HEADER
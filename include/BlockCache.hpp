@@ -0,0 +1,205 @@
+#ifndef BLOCK_CACHE_HEADER
+#define BLOCK_CACHE_HEADER
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "DecodeCache.hpp"
+#include "BitsUtilities.hpp"
+
+struct JitState;
+
+/// @brief Caché de bloques básicos: secuencias de instrucciones sin saltos que terminan en una transferencia de control
+class BlockCache {
+public:
+    /// @brief Operación pre-enlazada de un bloque, el handler recibe el operando leído al traducir
+    struct Operation {
+        DecodeCache::Handler handler{ nullptr };
+
+        /// @brief Ciclos acumulados del bloque hasta esta operación incluida
+        uint32_t cyclesUntil{ 0 };
+
+        uint16_t operand{ 0 };
+        uint8_t opcode{ 0 };
+
+        /// @brief Bytes que avanza el pc antes de llamar al handler, 0 si lo lee el propio handler
+        uint8_t length{ 0 };
+    };
+
+    /// @brief Código nativo de un bloque, devuelve los ciclos acumulados hasta la última operación ejecutada
+    using NativeCode = uint32_t(*)(JitState* state);
+
+    /// @brief Bloque básico traducido
+    struct Block {
+        uint16_t start{ 0 };
+        uint32_t end{ 0 };
+
+        /// @brief Ciclos de todas las operaciones menos la última, cuyo coste real lo devuelve su handler
+        uint32_t bodyCycles{ 0 };
+
+        std::vector<Operation> operations;
+
+        /// @brief Alguna operación antes de la última accede a memoria de datos, que puede caer en una página de E/S
+        bool accessesMemory{ false };
+
+        /// @brief Sucesores conocidos al traducir el bloque (fallthrough y destino de saltos directos)
+        std::array<uint16_t, 2> successors{ };
+        uint8_t successorsNumber{ 0 };
+
+        /// @brief Bloques encadenados a cada sucesor, se resuelven la primera vez que se recorren
+        std::array<Block*, 2> links{ };
+
+        bool valid{ true };
+
+        /// @brief Veces que se ha ejecutado el bloque interpretado, para decidir cuándo compilarlo
+        uint32_t executions{ 0 };
+
+        /// @brief Código nativo que ejecuta las primeras nativeOperations operaciones, si el bloque se ha compilado
+        NativeCode native{ nullptr };
+        uint8_t nativeOperations{ 0 };
+    };
+
+    static constexpr uint16_t Page_Size{ 256 };
+    static constexpr uint16_t Pages_Number{ 256 };
+    static constexpr uint16_t Max_Block_Instructions{ 64 };
+
+    /// @brief Bloques invalidados que se acumulan antes de vaciar la caché
+    static constexpr size_t Max_Invalid_Blocks{ 1024 };
+
+    /// @brief Busca el bloque que empieza en una dirección
+    /// @param pc Dirección de inicio
+    /// @return Bloque o nullptr si no está traducido
+    [[nodiscard]]
+    Block* find(uint16_t pc) const noexcept;
+
+    /// @brief Guarda un bloque traducido y lo registra en todas las páginas que ocupa
+    /// @param block Bloque a guardar
+    /// @return Referencia al bloque guardado
+    Block& insert(std::unique_ptr<Block> block);
+
+    /// @brief Invalida los bloques que contienen la dirección escrita
+    /// @param address Dirección escrita
+    /// @return true si se ha invalidado algún bloque
+    bool invalidate(uint16_t address);
+
+    /// @brief Invalida todos los bloques que ocupan algún byte de una página
+    /// @param page Número de página (byte alto de la dirección)
+    /// @return true si se ha invalidado algún bloque
+    bool invalidatePage(uint8_t page) noexcept;
+
+    /// @brief Indica si hay suficientes bloques invalidados como para vaciar la caché
+    [[nodiscard]]
+    bool needsCollection() const noexcept;
+
+    /// @brief Vacía la caché, invalidando todos los punteros a bloques
+    void clear() noexcept;
+
+private:
+    using Page = std::array<Block*, Page_Size>;
+
+    std::vector<std::unique_ptr<Block>> blocks_m;
+    std::array<std::unique_ptr<Page>, Pages_Number> starts_m;
+
+    /// @brief Bloques que ocupan al menos un byte de cada página
+    std::array<std::vector<Block*>, Pages_Number> pageBlocks_m;
+
+    size_t invalidBlocks_m{ 0 };
+};
+
+inline BlockCache::Block* BlockCache::find(uint16_t pc) const noexcept {
+    const auto& page{ starts_m[getHighByte(pc)] };
+
+    if (!page) {
+        return nullptr;
+    }
+
+    return (*page)[getLowBytes(pc)];
+}
+
+inline BlockCache::Block& BlockCache::insert(std::unique_ptr<Block> block) {
+    auto& page{ starts_m[getHighByte(block->start)] };
+
+    if (!page) {
+        page = std::make_unique<Page>();
+    }
+
+    (*page)[getLowBytes(block->start)] = block.get();
+
+    const auto lastPage{ static_cast<uint8_t>((block->end - 1) >> 8) };
+    for (uint16_t number{ getHighByte(block->start) }; number <= lastPage; ++number) {
+        pageBlocks_m[number].push_back(block.get());
+    }
+
+    blocks_m.push_back(std::move(block));
+    return *blocks_m.back();
+}
+
+inline bool BlockCache::invalidate(uint16_t address) {
+    auto& blocks{ pageBlocks_m[getHighByte(address)] };
+
+    if (blocks.empty()) [[likely]] {
+        return false;
+    }
+
+    bool invalidated{ false };
+
+    for (auto it{ blocks.begin() }; it != blocks.end(); ) {
+        Block* block{ *it };
+
+        if (address < block->start || address >= block->end) {
+            ++it;
+            continue;
+        }
+
+        // Los bloques invalidados siguen vivos hasta vaciar la caché, los enlaces hacia ellos comprueban valid
+        if (block->valid) {
+            block->valid = false;
+            (*starts_m[getHighByte(block->start)])[getLowBytes(block->start)] = nullptr;
+            ++invalidBlocks_m;
+        }
+
+        it = blocks.erase(it);
+        invalidated = true;
+    }
+
+    return invalidated;
+}
+
+inline bool BlockCache::invalidatePage(uint8_t page) noexcept {
+    auto& blocks{ pageBlocks_m[page] };
+
+    if (blocks.empty()) {
+        return false;
+    }
+
+    for (Block* block : blocks) {
+        if (block->valid) {
+            block->valid = false;
+            (*starts_m[getHighByte(block->start)])[getLowBytes(block->start)] = nullptr;
+            ++invalidBlocks_m;
+        }
+    }
+
+    blocks.clear();
+    return true;
+}
+
+inline bool BlockCache::needsCollection() const noexcept {
+    return invalidBlocks_m >= Max_Invalid_Blocks;
+}
+
+inline void BlockCache::clear() noexcept {
+    for (auto& page : starts_m) {
+        page.reset();
+    }
+
+    for (auto& blocks : pageBlocks_m) {
+        blocks.clear();
+    }
+
+    blocks_m.clear();
+    invalidBlocks_m = 0;
+}
+
+#endif // !BLOCK_CACHE_HEADER
@@ -6,17 +6,126 @@
 #include <stdexcept>
 #include "Registers.hpp"
 #include <limits>
+#include <algorithm>
+#include <utility>
 #include "OpcodesCycles.hpp"
+#include "DecodeCache.hpp"
+#include "BlockCache.hpp"
+#include "AotProgram.hpp"
+#include "MemoryBus.hpp"
+#include "PortBus.hpp"
+#include "Scheduler.hpp"
+#include <vector>
+
+#if defined(FAKE8080_JIT)
+#include "JitCompiler.hpp"
+#endif
+
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::musttail)
+#define FAKE8080_MUSTTAIL [[clang::musttail]]
+#elif __has_cpp_attribute(gnu::musttail)
+#define FAKE8080_MUSTTAIL [[gnu::musttail]]
+#endif
+#endif
+
+#if !defined(FAKE8080_MUSTTAIL)
+#define FAKE8080_MUSTTAIL
+#endif
 
 class CPUTest;
 
 class CPU {
     friend class CPUTest;
+    friend class AotCompiler;
+    friend struct AotRuntime;
     
 public:
+    /// @brief Carga la ROM y reinicia el pc. Un buffer de 64 KiB se usa directamente como memoria, sin copiarlo;
+    /// uno más pequeño se copia a partir de la dirección 0 y el resto de la memoria queda a 0
+    /// @param rom Imagen de como mucho 64 KiB
     void setROM(std::span<uint8_t> rom);
 
-    void cycle();
+    /// @brief Copia la ROM a la memoria del bus y reinicia el pc, para imágenes de solo lectura como las proyectadas
+    /// por RomImage
+    /// @param rom Imagen de como mucho 64 KiB
+    void loadROM(std::span<const uint8_t> rom);
+
+    /// @brief Bus de memoria, para configurar su mapa de páginas. El mapa se conserva al llamar a setROM
+    /// @return Bus de memoria de la CPU
+    [[nodiscard]]
+    MemoryBus& memoryBus() noexcept {
+        return memory_m;
+    }
+
+    /// @brief Puertos de E/S, para asociar los dispositivos de la máquina
+    /// @return Bus de puertos de la CPU
+    [[nodiscard]]
+    PortBus& portBus() noexcept {
+        return ports_m;
+    }
+
+    /// @brief Planificador de eventos de los dispositivos, sus plazos se miden en ciclos de getCycles()
+    /// @return Planificador de la CPU
+    [[nodiscard]]
+    Scheduler& scheduler() noexcept {
+        return scheduler_m;
+    }
+
+    /// @brief Ciclos ejecutados con run() desde que se creó la CPU. Desde los handlers de los puertos y de las páginas
+    /// de E/S incluye la porción en curso hasta el ciclo en que empezó la instrucción que los llama
+    [[nodiscard]]
+    uint64_t getCycles() const noexcept {
+        return cycles_m + sliceCycles_m;
+    }
+
+    /// @brief Solicita una interrupción externa, que inyecta un RST n cuando INTE lo permite. Igual que el dispositivo
+    /// que pone su instrucción en el bus, una solicitud nueva sustituye a la que estuviera pendiente. run() solo la
+    /// atiende en la siguiente frontera de evento del planificador, así que los dispositivos deben solicitarla desde
+    /// sus eventos
+    /// @param vector Número del RST, de 0 a 7
+    void requestInterrupt(uint8_t vector) noexcept {
+        pendingInterrupt_m = vector & 0b111;
+        interruptCheck_m = true;
+    }
+
+    /// @brief Indica si las interrupciones están habilitadas (INTE)
+    [[nodiscard]]
+    bool isInterruptEnabled() const noexcept {
+        return interruptsEnabled_m;
+    }
+
+    /// @brief Indica si la CPU está detenida por HLT esperando una interrupción
+    [[nodiscard]]
+    bool isHalted() const noexcept {
+        return halted_m;
+    }
+
+    /// @brief Cambia el banco visible en un rango de páginas sin copiar memoria, descartando solo el código
+    /// decodificado o traducido de esas páginas
+    /// @param first Primera dirección, al inicio de una página
+    /// @param last Última dirección, al final de una página
+    /// @param bank Memoria del banco, del mismo tamaño que el rango
+    /// @param writable false para que el banco se comporte como ROM
+    void switchBank(uint16_t first, uint16_t last, std::span<uint8_t> bank, bool writable = true);
+
+#if defined(FAKE8080_DISPATCH_AOT)
+    /// @brief Instala un programa generado por fake8080_aot, se debe llamar después de setROM
+    /// @param program Programa traducido a partir de la ROM cargada
+    void setProgram(const AotProgram& program);
+#endif
+
+    /// @brief Ejecuta una única instrucción. Las interrupciones solo se aceptan en run()
+    /// @return Número de ciclos usados
+    uint8_t cycle();
+
+    /// @brief Ejecuta instrucciones hasta agotar el presupuesto de ciclos. Entre evento y evento del planificador se
+    /// ejecuta sin interrupciones y los eventos se disparan en la primera frontera de instrucción que alcanza su plazo,
+    /// incluidos los que vencen al agotar el presupuesto. Las interrupciones que
+    /// soliciten los eventos se aceptan en esa misma frontera si INTE está activo
+    /// @param cycleBudget Ciclos disponibles, la última instrucción puede excederlo
+    /// @return Número de ciclos realmente ejecutados
+    uint64_t run(uint64_t cycleBudget);
 
 private:
     enum class AritmeticOperation : uint8_t { ADD = 0, SUB };
@@ -25,16 +134,383 @@ private:
 
     using MemberFunction = uint8_t(CPU::*)();
 
+    /// @brief Handlers de las instrucciones de 2 y 3 bytes que reciben el operando ya leído, con el pc tras la
+    /// instrucción. Los de la tabla de despacho (sufijos _d8, _d16 y _a16) leen el operando y llaman a estos
+    using ByteOperandFunction = uint8_t(CPU::*)(uint8_t);
+    using WordOperandFunction = uint8_t(CPU::*)(uint16_t);
+
     static constexpr uint8_t Byte_Shift{ 8 };
     static constexpr uint16_t Opcodes_Number{ 256 };
 
-    static std::array<MemberFunction, Opcodes_Number> Opcodes;
+    /// @brief Codificación de registros en los campos DDD y SSS del opcode, el índice 6 es M
+    static constexpr std::array Encoded_Registers{
+        Registers::Register::B, Registers::Register::C, Registers::Register::D, Registers::Register::E,
+        Registers::Register::H, Registers::Register::L, Registers::Register::W, Registers::Register::A
+    };
+
+    static constexpr uint8_t Encoded_M{ 6 };
+
+    /// @brief Codificación de pares de registros en el campo RP del opcode
+    static constexpr std::array Encoded_Pairs{
+        Registers::CombinedRegister::BC, Registers::CombinedRegister::DE,
+        Registers::CombinedRegister::HL, Registers::CombinedRegister::SP
+    };
+
+    /// @brief Codificación del campo RP para PUSH y POP, donde SP se sustituye por PSW
+    static constexpr std::array Encoded_Stack_Pairs{
+        Registers::CombinedRegister::BC, Registers::CombinedRegister::DE,
+        Registers::CombinedRegister::HL, Registers::CombinedRegister::PSW
+    };
+
+    /// @brief Tabla de despacho generada en tiempo de compilación a partir de la codificación del 8080
+    static const std::array<MemberFunction, Opcodes_Number> Opcodes;
+
+    /// @brief Handlers de la tabla de despacho envueltos en funciones libres que reciben el operando pre-decodificado
+    static const std::array<DecodeCache::Handler, Opcodes_Number> Invokers;
+
+    /// @brief Longitud en bytes de cada instrucción
+    static const std::array<uint8_t, Opcodes_Number> Opcodes_Length;
+
+    /// @brief Ciclos base de cada instrucción, para los condicionales los de la rama no tomada
+    static const std::array<uint8_t, Opcodes_Number> Opcodes_Cycles;
+
+    /// @brief Genera la tabla de despacho completa
+    /// @return Tabla con un handler por opcode
+    static consteval std::array<MemberFunction, Opcodes_Number> makeOpcodesTable();
+
+    /// @brief Obtiene el handler de un opcode a partir de sus campos de bits
+    /// @tparam Opcode Opcode a decodificar
+    /// @return Handler del opcode, nullptr si la codificación no está cubierta
+    template<uint8_t Opcode>
+    static consteval MemberFunction decodeOpcode();
+
+    /// @brief Decodifica los opcodes 00xxxxxx
+    template<uint8_t Opcode>
+    static consteval MemberFunction decodeMiscellaneous();
 
-    std::span<uint8_t> rom_m;
+    /// @brief Decodifica los opcodes 01DDDSSS (MOV)
+    template<uint8_t Opcode>
+    static consteval MemberFunction decodeMOV();
+
+    /// @brief Decodifica los opcodes 10OOOSSS (ALU con registro o M)
+    template<uint8_t Opcode>
+    static consteval MemberFunction decodeALU();
+
+    /// @brief Decodifica los opcodes 11xxxxxx
+    template<uint8_t Opcode>
+    static consteval MemberFunction decodeControl();
+
+    /// @brief Obtiene el handler con operando de una instrucción de 2 bytes
+    template<uint8_t Opcode>
+    static consteval ByteOperandFunction decodeByteOperand();
+
+    /// @brief Obtiene el handler con operando de una instrucción de 3 bytes
+    template<uint8_t Opcode>
+    static consteval WordOperandFunction decodeWordOperand();
+
+    /// @brief Calcula la longitud de una instrucción a partir de su opcode
+    /// @param opcode Opcode a evaluar
+    /// @return Longitud en bytes
+    static consteval uint8_t instructionLength(uint8_t opcode);
+
+    /// @brief Calcula los ciclos base de una instrucción a partir de las constantes de OpcodesCycles.hpp
+    /// @param opcode Opcode a evaluar
+    /// @return Ciclos base, 0 si el opcode aún no está implementado
+    static consteval uint8_t instructionCycles(uint8_t opcode);
+
+    /// @brief Indica si un opcode termina un bloque básico (saltos, llamadas, retornos, RST y los que cambian el estado de la máquina)
+    /// @param opcode Opcode a evaluar
+    /// @return true si la instrucción cierra el bloque
+    static consteval bool endsBlock(uint8_t opcode);
+
+    /// @brief Indica si un opcode puede llamar a handlers de dispositivos: IN, OUT y los accesos a memoria que no son
+    /// de búsqueda de instrucciones, que pueden caer en una página de E/S. Antes de ellos los backends publican
+    /// sliceCycles_m
+    /// @param opcode Opcode a evaluar
+    /// @return true si la instrucción accede a puertos o a memoria de datos
+    static constexpr bool accessesDevices(uint8_t opcode) noexcept;
+
+    /// @brief Indica para cada opcode si termina un bloque básico
+    static const std::array<bool, Opcodes_Number> Block_Terminators;
+
+    MemoryBus memory_m;
+    PortBus ports_m;
+
+    Scheduler scheduler_m;
+
+    /// @brief Reloj del planificador
+    uint64_t cycles_m{ 0 };
+
+    static constexpr uint8_t No_Interrupt{ 0xFF };
+
+    /// @brief Flip-flop INTE
+    bool interruptsEnabled_m{ false };
+    bool halted_m{ false };
+
+    /// @brief RST solicitado que aún no se ha aceptado, o No_Interrupt
+    uint8_t pendingInterrupt_m{ No_Interrupt };
+
+    /// @brief Avisa a run() de que hay una solicitud nueva, mientras esté a false no se mira nada entre eventos
+    bool interruptCheck_m{ false };
+
+    /// @brief EI acaba de ejecutarse y run() debe ejecutar la instrucción siguiente antes de aceptar interrupciones
+    bool eiShadow_m{ false };
 
     uint16_t pc_m{ 0 };
     Registers registers_m;
 
+    // Las cachés solo existen en su backend, el resto no paga su tamaño en cada instancia
+#if defined(FAKE8080_DISPATCH_DECODE_CACHE)
+    DecodeCache decodeCache_m;
+#endif
+
+#if defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+    BlockCache blockCache_m;
+#endif
+
+    /// @brief Se activa cuando una escritura invalida un bloque traducido
+    bool codeModified_m{ false };
+
+#if defined(FAKE8080_JIT)
+    JitCompiler jit_m;
+#endif
+
+#if defined(FAKE8080_DISPATCH_AOT)
+    const AotProgram* program_m{ nullptr };
+
+    /// @brief Bloque traducido que empieza en cada dirección, nullptr si no hay o se ha modificado su código
+    std::vector<const AotProgram::Block*> programBlocks_m;
+
+    /// @brief Direcciones ocupadas por algún bloque traducido
+    std::vector<bool> programCode_m;
+#endif
+
+    /// @brief Mayor distancia de un salto hacia atrás para considerar que puede cerrar un bucle de espera
+    static constexpr uint8_t Max_Idle_Loop_Bytes{ 16 };
+
+    /// @brief Bucle candidato a ser de espera: un salto corto hacia atrás cuyo cuerpo no tiene más saltos, solo lee
+    /// memoria fuera de las páginas de E/S y solo modifica A y flags. Si una vuelta deja A y F como estaban al
+    /// empezarla, todas las siguientes serán idénticas hasta que un evento cambie algo
+    struct IdleLoop {
+        uint16_t start{ 0 };
+
+        /// @brief Dirección siguiente al salto que cierra el bucle
+        uint16_t end{ 0 };
+
+        /// @brief Ciclos de una vuelta, 0 si el cuerpo no cumple las condiciones
+        uint8_t cycles{ 0 };
+
+        /// @brief Se ha completado una vuelta en esta porción y a y f guardan su estado final
+        bool armed{ false };
+
+        uint8_t a{ 0 };
+        uint8_t f{ 0 };
+    };
+
+    IdleLoop idleLoop_m;
+
+    /// @brief Presupuesto de la porción en curso. HLT y los bucles de espera lo ponen a 0 para cortarla y el
+    /// planificador lo reduce al programar un evento dentro de ella, los backends solo lo vuelven a leer tras las
+    /// instrucciones que terminan un bloque o acceden a un dispositivo
+    uint64_t sliceBudget_m{ 0 };
+
+    /// @brief Ciclos de la porción en curso hasta la instrucción que accede a un dispositivo, que getCycles() suma a
+    /// cycles_m. Los backends solo lo publican antes de las instrucciones de accessesDevices
+    uint64_t sliceCycles_m{ 0 };
+
+    /// @brief Ciclos de una vuelta del bucle de espera que ha cortado la porción, 0 si no la ha cortado ninguno
+    uint8_t idleCycles_m{ 0 };
+
+    /// @brief Dirección en la que empieza cada vuelta del bucle de espera
+    uint16_t idlePC_m{ 0 };
+
+    /// @brief Ejecuta el backend de despacho seleccionado sin atender al planificador
+    /// @param cycleBudget Ciclos disponibles
+    /// @return Número de ciclos realmente ejecutados
+    uint64_t runSlice(uint64_t cycleBudget);
+
+    /// @brief Corta la porción en curso para que run() adelante el reloj sobre un bucle que no cambia nada
+    /// @param loopCycles Ciclos de una vuelta, que empieza en el pc actual
+    void enterIdle(uint8_t loopCycles) noexcept {
+        idleCycles_m = loopCycles;
+        idlePC_m = pc_m;
+        sliceBudget_m = 0;
+    }
+
+    /// @brief Avisa de un salto tomado, los cortos hacia atrás pueden cerrar un bucle de espera
+    /// @param end Dirección siguiente a la instrucción de salto
+    void jumpTaken(uint16_t end) {
+        const auto length{ static_cast<uint16_t>(end - pc_m) };
+
+        if (length >= Opcodes_Length[0xC3] && length <= Max_Idle_Loop_Bytes) [[unlikely]] {
+            checkIdleLoop(end);
+        }
+    }
+
+    /// @brief Comprueba si la vuelta que acaba de cerrar un salto hacia atrás ha dejado el estado como estaba
+    /// @param end Dirección siguiente a la instrucción de salto, el pc ya apunta al inicio del bucle
+    void checkIdleLoop(uint16_t end);
+
+    /// @brief Analiza el cuerpo de un bucle candidato a ser de espera
+    /// @param start Inicio del bucle
+    /// @param end Dirección siguiente al salto que lo cierra
+    /// @return Ciclos de una vuelta, 0 si alguna instrucción no cumple las condiciones de IdleLoop
+    [[nodiscard]]
+    uint8_t idleLoopCycles(uint16_t start, uint16_t end) const;
+
+    /// @brief Indica si un opcode puede formar parte del cuerpo de un bucle de espera
+    /// @param opcode Opcode a evaluar
+    /// @return true si no salta, no escribe memoria ni puertos y solo modifica A y flags
+    static constexpr bool isIdleSafe(uint8_t opcode) noexcept;
+
+    /// @brief Adelanta el reloj sobre las vueltas completas del bucle de espera que caben antes del final de la porción
+    /// @param remainingCycles Ciclos que le quedaban a la porción cortada
+    /// @return Ciclos adelantados
+    uint64_t skipIdleLoop(uint64_t remainingCycles);
+
+    /// @brief Bucle de ejecución con despacho por tabla de punteros a miembro
+    /// @param cycleBudget Ciclos disponibles
+    /// @return Número de ciclos realmente ejecutados
+    uint64_t runTable(uint64_t cycleBudget);
+
+    /// @brief Bucle de ejecución con despacho encadenado mediante computed goto (GCC/Clang)
+    /// @param cycleBudget Ciclos disponibles
+    /// @return Número de ciclos realmente ejecutados
+    uint64_t runThreaded(uint64_t cycleBudget);
+
+    /// @brief Ejecuta el handler de un opcode conocido en tiempo de compilación, permitiendo su inlining
+    /// @tparam Opcode Opcode a ejecutar
+    /// @return Número de ciclos usados
+    template<uint8_t Opcode>
+    uint8_t execute();
+
+    /// @brief Ejecuta el handler de un opcode desde una función libre, el pc ya debe apuntar tras la instrucción
+    /// @tparam Opcode Opcode a ejecutar
+    /// @param cpu CPU sobre la que se ejecuta
+    /// @param operand Operando de 8 o 16 bits ya leído, se ignora en las instrucciones de 1 byte
+    /// @return Número de ciclos usados
+    template<uint8_t Opcode>
+    static uint8_t invoke(CPU& cpu, uint16_t operand);
+
+    /// @brief Ejecuta la instrucción en pc leyendo sus operandos de memoria, para las que no se pueden pre-decodificar
+    /// @param cpu CPU sobre la que se ejecuta
+    /// @return Número de ciclos usados
+    static uint8_t fetchAndExecute(CPU& cpu, uint16_t);
+
+    /// @brief Bucle de ejecución sobre la caché de instrucciones pre-decodificadas
+    /// @param cycleBudget Ciclos disponibles
+    /// @return Número de ciclos realmente ejecutados
+    uint64_t runDecoded(uint64_t cycleBudget);
+
+    /// @brief Decodifica la instrucción en pc y la guarda en la caché
+    /// @param pc Dirección de la instrucción
+    /// @return Instrucción decodificada
+    const DecodeCache::Instruction& decode(uint16_t pc);
+
+    /// @brief Lee el operando inmediato de la instrucción en pc
+    /// @param pc Dirección de la instrucción
+    /// @return Operando de 8 o 16 bits, 0 si la instrucción no tiene
+    [[nodiscard]]
+    uint16_t readOperand(uint16_t pc) const;
+
+    /// @brief Bucle de ejecución por bloques básicos encadenados, el presupuesto se comprueba entre bloques
+    /// @param cycleBudget Ciclos disponibles
+    /// @return Número de ciclos realmente ejecutados
+    uint64_t runBlocks(uint64_t cycleBudget);
+
+    /// @brief Obtiene el bloque que empieza en pc, siguiendo el enlace del bloque anterior si existe
+    /// @param previous Bloque ejecutado justo antes, o nullptr
+    /// @return Bloque a ejecutar
+    BlockCache::Block& nextBlock(BlockCache::Block* previous);
+
+    /// @brief Traduce el bloque básico que empieza en pc y lo guarda en la caché
+    /// @param pc Dirección de inicio
+    /// @return Bloque traducido
+    BlockCache::Block& translateBlock(uint16_t pc);
+
+    /// @brief Vacía la caché de bloques y el código nativo que dependa de ella
+    void clearBlocks() noexcept;
+
+    /// @brief Reinicia el pc y descarta todo el código decodificado o traducido de la ROM anterior
+    void reset();
+
+    /// @brief Acepta la interrupción pendiente: deshabilita INTE, despierta la CPU y ejecuta el RST inyectado
+    /// @return Ciclos del RST
+    uint8_t acceptInterrupt();
+
+    /// @brief Descarta el código decodificado o traducido de un rango de páginas cuyo contenido ha cambiado
+    /// @param first Primera dirección del rango
+    /// @param last Última dirección del rango
+    void invalidateCode(uint16_t first, uint16_t last);
+
+#if defined(FAKE8080_DISPATCH_AOT)
+    /// @brief Bucle de ejecución sobre el programa traducido por fake8080_aot, lo que no está traducido se interpreta
+    /// @param cycleBudget Ciclos disponibles
+    /// @return Número de ciclos realmente ejecutados
+    uint64_t runProgram(uint64_t cycleBudget);
+
+    /// @brief Descarta los bloques traducidos que contienen una dirección escrita
+    /// @param address Dirección escrita
+    void discardProgramBlocks(uint16_t address);
+
+    /// @brief Descarta los bloques traducidos que ocupan algún byte de un rango
+    /// @param first Primera dirección del rango
+    /// @param last Última dirección del rango
+    void discardProgramBlocks(uint16_t first, uint16_t last);
+#endif
+
+#if defined(FAKE8080_JIT)
+    /// @brief Ejecuta el código nativo de un bloque volcando el estado del 8080 a JitState y de vuelta
+    /// @param block Bloque compilado
+    /// @return Ciclos acumulados hasta la última operación ejecutada
+    uint32_t runNative(const BlockCache::Block& block);
+
+    /// @brief Lectura de memoria para el código nativo
+    static uint8_t jitRead(CPU& cpu, uint16_t address);
+
+    /// @brief Escritura de memoria para el código nativo
+    /// @return Distinto de 0 si la escritura ha invalidado código traducido
+    static uint8_t jitWrite(CPU& cpu, uint16_t address, uint8_t value);
+#endif
+
+    /// @brief Handler del backend por tail calls, el pc, A y F viajan en registros de la máquina como argumentos
+    using TailCallHandler = uint64_t(*)(CPU& cpu, uint16_t pc, uint8_t a, uint8_t f, uint64_t executedCycles, uint64_t cycleBudget);
+
+    /// @brief Estado caliente que un handler lee o escribe fuera de registers_m
+    enum HotState : uint8_t { Hot_PC = 1 << 0, Hot_A = 1 << 1, Hot_F = 1 << 2, Hot_All = Hot_PC | Hot_A | Hot_F };
+
+    /// @brief Tabla de handlers del backend por tail calls
+    static const std::array<TailCallHandler, Opcodes_Number> TailCallHandlers;
+
+    /// @brief Bucle de ejecución en el que cada handler salta al siguiente mediante un tail call
+    /// @param cycleBudget Ciclos disponibles
+    /// @return Número de ciclos realmente ejecutados
+    uint64_t runTailCall(uint64_t cycleBudget);
+
+    /// @brief Comprueba el presupuesto y salta al handler del siguiente opcode, o vuelca el estado y termina
+    static uint64_t dispatchTailCall(CPU& cpu, uint16_t pc, uint8_t a, uint8_t f, uint64_t executedCycles, uint64_t cycleBudget);
+
+    /// @brief Handler por tail calls de un opcode, implementa de forma nativa los más comunes
+    /// y delega el resto en los handlers plantilla volcando solo el estado caliente que usan
+    template<uint8_t Opcode>
+    static uint64_t tailCallHandler(CPU& cpu, uint16_t pc, uint8_t a, uint8_t f, uint64_t executedCycles, uint64_t cycleBudget);
+
+    /// @brief Indica qué partes del estado caliente (pc, A, F) usa el handler de un opcode
+    /// @param opcode Opcode a evaluar
+    /// @return Máscara de HotState
+    static consteval uint8_t hotStateUsage(uint8_t opcode);
+
+    /// @brief Lee un byte de memoria
+    /// @param address Dirección a leer
+    /// @return Byte leído
+    [[nodiscard]]
+    uint8_t readMemory(uint16_t address) const;
+
+    /// @brief Escribe un byte en memoria invalidando el código decodificado que lo contenga
+    /// @param address Dirección a escribir
+    /// @param value Valor a escribir
+    void writeMemory(uint16_t address, uint8_t value);
+
     /// @brief Lee el siguiente byte e incrementa el pc
     /// @return Byte leído
     [[nodiscard]]
@@ -62,8 +538,24 @@ private:
     /// @brief Escribe W en [HL]
     void writeWtoM();
 
+    /// @brief Escribe un valor de 16 bits en el stack, primero el byte alto
+    /// @param value Valor a escribir
+    void pushWord(uint16_t value);
+
+    /// @brief Lee un valor de 16 bits del stack
+    /// @return Valor leído
+    [[nodiscard]]
+    uint16_t popWord();
+
+    /// @brief Evalúa la condición de un Jcc, Ccc o Rcc con una sola consulta a Conditions_Table
+    /// @tparam Condition Campo ccc del opcode
+    /// @return true si se cumple
+    template <uint8_t Condition>
+    [[nodiscard]]
+    bool conditionMet() const noexcept;
+
     [[noreturn]]
-    void InvalidOpcode();
+    uint8_t InvalidOpcode();
 
     /// @brief Establece el zero flag si el valor es cero
     /// @param value Valor a evaluar
@@ -161,9 +653,15 @@ private:
     template<AritmeticOperation Op, bool useCarry, bool storeResult>
     uint8_t ADI_ACI_SUI_SBI_CPI_d8();
 
+    template<AritmeticOperation Op, bool useCarry, bool storeResult>
+    uint8_t ADI_ACI_SUI_SBI_CPI(uint8_t value);
+
     template<LogicOperation Op>
     uint8_t ANI_ORI_XRI_d8();
 
+    template<LogicOperation Op>
+    uint8_t ANI_ORI_XRI(uint8_t value);
+
     template<Registers::Register R>
     uint8_t ADD_R();
 
@@ -220,6 +718,9 @@ private:
     template<Registers::Register R>
     uint8_t MVI_R_d8();
 
+    template<Registers::Register R>
+    uint8_t MVI_R(uint8_t value);
+
     template<Registers::Register R>
     uint8_t MOV_M_R();
 
@@ -248,6 +749,8 @@ private:
 
     uint8_t MVI_M_d8();
 
+    uint8_t MVI_M(uint8_t value);
+
     template<Registers::CombinedRegister RR>
     uint8_t INX_RR();
 
@@ -260,10 +763,17 @@ private:
     template<Registers::CombinedRegister RR>
     uint8_t LXI_RR_d16();
 
+    template<Registers::CombinedRegister RR>
+    uint8_t LXI_RR(uint16_t value);
+
     uint8_t SHLD_a16();
 
+    uint8_t SHLD(uint16_t address);
+
     uint8_t LHLD_a16();
 
+    uint8_t LHLD(uint16_t address);
+
     uint8_t ADI_d8();
 
     uint8_t ACI_d8();
@@ -285,11 +795,15 @@ private:
 
     uint8_t STA_a16();
 
+    uint8_t STA(uint16_t address);
+
     template<Registers::CombinedRegister RR>
     uint8_t LDAX_RR();
 
     uint8_t LDA_a16();
 
+    uint8_t LDA(uint16_t address);
+
     template<Registers::CombinedRegister RR>
     uint8_t PUSH_RR();
 
@@ -299,6 +813,58 @@ private:
     uint8_t XTHL();
 
     uint8_t XCHG();
+
+    uint8_t SPHL();
+
+    uint8_t OUT_d8();
+
+    uint8_t OUT(uint8_t port);
+
+    uint8_t IN_d8();
+
+    uint8_t IN(uint8_t port);
+
+    uint8_t NOP();
+
+    uint8_t JMP_a16();
+
+    uint8_t JMP(uint16_t address);
+
+    template<uint8_t Condition>
+    uint8_t Jcc_a16();
+
+    template<uint8_t Condition>
+    uint8_t Jcc(uint16_t address);
+
+    uint8_t CALL_a16();
+
+    uint8_t CALL(uint16_t address);
+
+    template<uint8_t Condition>
+    uint8_t Ccc_a16();
+
+    template<uint8_t Condition>
+    uint8_t Ccc(uint16_t address);
+
+    uint8_t RET();
+
+    template<uint8_t Condition>
+    uint8_t Rcc();
+
+    uint8_t PCHL();
+
+    template<uint8_t Vector>
+    uint8_t RST_n();
+
+    uint8_t DI();
+
+    /// @brief Habilita INTE. Una interrupción no se acepta hasta después de la instrucción siguiente, así que corta la
+    /// porción y run() ejecuta esa instrucción por separado para que el retraso sea igual en todos los backends
+    uint8_t EI();
+
+    /// @brief Detiene la CPU hasta la próxima interrupción. El pc vuelve al HLT para que todos los backends lo sigan
+    /// ejecutando mientras tanto, al aceptar la interrupción se apila la dirección siguiente
+    uint8_t HLT();
 };
 
 template <Registers::Register R>
@@ -380,21 +946,26 @@ inline uint8_t CPU::MOV_R_R() {
 
 template <Registers::Register R>
 inline uint8_t CPU::MVI_R_d8() {
-    registers_m.setRegister(R, readNextByte());
+    return MVI_R<R>(readNextByte());
+}
+
+template <Registers::Register R>
+inline uint8_t CPU::MVI_R(uint8_t value) {
+    registers_m.setRegister(R, value);
 
     return MVI_R_d8_Cycles;
 }
 
 template <Registers::Register R>
 inline uint8_t CPU::MOV_M_R() {
-    rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::HL)] = registers_m.getRegister(R);
+    writeMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::HL), registers_m.getRegister(R));
 
     return MOV_M_R_Cycles;
 }
 
 template <Registers::Register R>
 inline uint8_t CPU::MOV_R_M() {
-    registers_m.setRegister(R, rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::HL)]);
+    registers_m.setRegister(R, readMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::HL)));
 
     return MOV_R_M_Cycles;
 }
@@ -416,12 +987,7 @@ inline uint8_t CPU::DAD_RR() {
 
     const uint16_t result = HL_value + RR_value;
 
-    if (result < HL_value) {
-        registers_m.setFlag(Registers::Flags::CY, true);
-    } 
-    else {
-        registers_m.setFlag(Registers::Flags::CY, false);
-    }
+    registers_m.setFlags(Flag_CY, result < HL_value ? Flag_CY : 0);
 
     registers_m.setCombinedRegister(Registers::CombinedRegister::HL, result);
     
@@ -430,7 +996,12 @@ inline uint8_t CPU::DAD_RR() {
 
 template <Registers::CombinedRegister RR>
 inline uint8_t CPU::LXI_RR_d16() {
-    registers_m.setCombinedRegister(RR, readNextTwoBytes());
+    return LXI_RR<RR>(readNextTwoBytes());
+}
+
+template <Registers::CombinedRegister RR>
+inline uint8_t CPU::LXI_RR(uint16_t value) {
+    registers_m.setCombinedRegister(RR, value);
 
     return LXI_Cycles;
 }
@@ -496,11 +1067,13 @@ inline uint8_t CPU::ANA_ORA_XRA_R() {
         break;
     }
 
-    manageZeroFlag(result);
-    manageSignedFlag(result);
-    manageParityFlag(result);
-    registers_m.setFlag(Registers::Flags::CY, 0);
-    registers_m.setFlag(Registers::Flags::AC, (Op == LogicOperation::AND ? 1 : 0));
+    if constexpr (Lazy_Flags_Enabled) {
+        registers_m.deferLogicFlags(result, Op == LogicOperation::AND);
+    }
+    else {
+        const uint8_t flags = Flags_SZP[result] | (Op == LogicOperation::AND ? Flag_AC : 0);
+        registers_m.setFlags(Flags_SZACPCY, flags);
+    }
 
     registers_m.setRegister(Registers::Register::A, result);
 
@@ -528,7 +1101,7 @@ inline uint8_t CPU::RLC_RRC_RAL_RAR_R() {
     
     registerValue = setBit(registerValue, direction == ShiftDirection::RIGHT ? 7 : 0, useCY ? dropedBit : registers_m.getFlag(Registers::Flags::CY));
 
-    registers_m.setFlag(Registers::Flags::CY, dropedBit);
+    registers_m.setFlags(Flag_CY, dropedBit ? Flag_CY : 0);
     registers_m.setRegister(R, registerValue);
 
     return RLC_RRC_RAL_RAR_Cycles;
@@ -544,7 +1117,12 @@ inline uint8_t CPU::INX_DCX_RR() {
 
 template <CPU::AritmeticOperation Op, bool useCarry, bool storeResult>
 inline uint8_t CPU::ADI_ACI_SUI_SBI_CPI_d8() {
-    registers_m.setRegister(Registers::Register::W, readNextByte());
+    return ADI_ACI_SUI_SBI_CPI<Op, useCarry, storeResult>(readNextByte());
+}
+
+template <CPU::AritmeticOperation Op, bool useCarry, bool storeResult>
+inline uint8_t CPU::ADI_ACI_SUI_SBI_CPI(uint8_t value) {
+    registers_m.setRegister(Registers::Register::W, value);
     ADD_ADC_SUB_SBB_CMP_R<Registers::Register::W, Op, useCarry, storeResult>();
     
     return ADI_ACI_SUI_SBI_CPI_d8_Cycles;
@@ -552,7 +1130,12 @@ inline uint8_t CPU::ADI_ACI_SUI_SBI_CPI_d8() {
 
 template <CPU::LogicOperation Op>
 inline uint8_t CPU::ANI_ORI_XRI_d8() {
-    registers_m.setRegister(Registers::Register::W, readNextByte());
+    return ANI_ORI_XRI<Op>(readNextByte());
+}
+
+template <CPU::LogicOperation Op>
+inline uint8_t CPU::ANI_ORI_XRI(uint8_t value) {
+    registers_m.setRegister(Registers::Register::W, value);
     ANA_ORA_XRA_R<Registers::Register::W, Op>();
 
     return ANI_ORI_XRI_d8_Cycles;
@@ -560,14 +1143,14 @@ inline uint8_t CPU::ANI_ORI_XRI_d8() {
 
 template <Registers::CombinedRegister RR>
 inline uint8_t CPU::STAX_RR() {
-    rom_m[registers_m.getCombinedRegister(RR)] = registers_m.getRegister(Registers::Register::A);
+    writeMemory(registers_m.getCombinedRegister(RR), registers_m.getRegister(Registers::Register::A));
 
     return STAX_RR_Cycles;
 }
 
 template <Registers::CombinedRegister RR>
 inline uint8_t CPU::LDAX_RR() {
-    registers_m.setRegister(Registers::Register::A, rom_m[registers_m.getCombinedRegister(RR)]);
+    registers_m.setRegister(Registers::Register::A, readMemory(registers_m.getCombinedRegister(RR)));
 
     return LDAX_RR_Cycles;
 }
@@ -578,22 +1161,22 @@ inline uint8_t CPU::PUSH_RR() {
 
     decreaseSP();
 
-    rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::SP)] = getHighByte(RR_value);
+    writeMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::SP), getHighByte(RR_value));
 
     decreaseSP();
 
-    rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::SP)] = getLowBytes(RR_value);
+    writeMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::SP), getLowBytes(RR_value));
 
     return PUSH_RR_Cycles;
 }
 
 template <Registers::CombinedRegister RR>
 inline uint8_t CPU::POP_RR() {
-    uint8_t lowByte{ rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::SP)] };
+    uint8_t lowByte{ readMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::SP)) };
 
     increaseSP();
 
-    uint8_t highByte{ rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::SP)] };
+    uint8_t highByte{ readMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::SP)) };
 
     increaseSP();
 
@@ -602,4 +1185,666 @@ inline uint8_t CPU::POP_RR() {
     return POP_RR_Cycles;
 }
 
+template <uint8_t Condition>
+inline bool CPU::conditionMet() const noexcept {
+    static_assert(Condition < Conditions_Number);
+    return Conditions_Table[Condition][registers_m.getRegister(Registers::Register::F)];
+}
+
+template <uint8_t Condition>
+inline uint8_t CPU::Jcc_a16() {
+    // La dirección se lee siempre, así el pc queda tras la instrucción si no se salta
+    return Jcc<Condition>(readNextTwoBytes());
+}
+
+template <uint8_t Condition>
+inline uint8_t CPU::Jcc(uint16_t address) {
+    if (conditionMet<Condition>()) {
+        const auto end{ pc_m };
+        pc_m = address;
+        jumpTaken(end);
+    }
+    else if (pc_m == idleLoop_m.end) {
+        // Salir del bucle invalida su última vuelta, la siguiente vez que se entre no será consecutiva
+        idleLoop_m.armed = false;
+    }
+
+    return Jcc_a16_Cycles;
+}
+
+template <uint8_t Condition>
+inline uint8_t CPU::Ccc_a16() {
+    return Ccc<Condition>(readNextTwoBytes());
+}
+
+template <uint8_t Condition>
+inline uint8_t CPU::Ccc(uint16_t address) {
+    if (!conditionMet<Condition>()) {
+        return Ccc_a16_Cycles;
+    }
+
+    pushWord(pc_m);
+    pc_m = address;
+
+    return Ccc_a16_Cycles + Ccc_a16_Taken_Extra_Cycles;
+}
+
+template <uint8_t Condition>
+inline uint8_t CPU::Rcc() {
+    if (!conditionMet<Condition>()) {
+        return Rcc_Cycles;
+    }
+
+    pc_m = popWord();
+
+    return Rcc_Cycles + Rcc_Taken_Extra_Cycles;
+}
+
+template <uint8_t Vector>
+inline uint8_t CPU::RST_n() {
+    pushWord(pc_m);
+    pc_m = Vector;
+
+    return RST_Cycles;
+}
+
+template <uint8_t Opcode>
+consteval CPU::MemberFunction CPU::decodeOpcode() {
+    if constexpr ((Opcode >> 6) == 0b00) {
+        return decodeMiscellaneous<Opcode>();
+    }
+    else if constexpr ((Opcode >> 6) == 0b01) {
+        return decodeMOV<Opcode>();
+    }
+    else if constexpr ((Opcode >> 6) == 0b10) {
+        return decodeALU<Opcode>();
+    }
+    else {
+        return decodeControl<Opcode>();
+    }
+}
+
+template <uint8_t Opcode>
+consteval CPU::MemberFunction CPU::decodeMiscellaneous() {
+    constexpr uint8_t ddd{ (Opcode >> 3) & 0b111 };
+    constexpr uint8_t rp{ (Opcode >> 4) & 0b11 };
+    constexpr auto R{ Encoded_Registers[ddd] };
+    constexpr auto RR{ Encoded_Pairs[rp] };
+
+    switch (Opcode & 0b111) {
+    case 0b000:
+        return &CPU::NOP;
+
+    case 0b001:
+        if constexpr ((Opcode & 0b1000) == 0) {
+            return &CPU::LXI_RR_d16<RR>;
+        }
+        else {
+            return &CPU::DAD_RR<RR>;
+        }
+
+    case 0b010:
+        if constexpr ((Opcode & 0b1000) == 0) {
+            if constexpr (rp < 2) {
+                return &CPU::STAX_RR<RR>;
+            }
+            else if constexpr (RR == Registers::CombinedRegister::HL) {
+                return &CPU::SHLD_a16;
+            }
+            else {
+                return &CPU::STA_a16;
+            }
+        }
+        else {
+            if constexpr (rp < 2) {
+                return &CPU::LDAX_RR<RR>;
+            }
+            else if constexpr (RR == Registers::CombinedRegister::HL) {
+                return &CPU::LHLD_a16;
+            }
+            else {
+                return &CPU::LDA_a16;
+            }
+        }
+
+    case 0b011:
+        if constexpr ((Opcode & 0b1000) == 0) {
+            return &CPU::INX_RR<RR>;
+        }
+        else {
+            return &CPU::DCX_RR<RR>;
+        }
+
+    case 0b100:
+        if constexpr (ddd == Encoded_M) {
+            return &CPU::INR_M;
+        }
+        else {
+            return &CPU::INR_R<R>;
+        }
+
+    case 0b101:
+        if constexpr (ddd == Encoded_M) {
+            return &CPU::DCR_M;
+        }
+        else {
+            return &CPU::DCR_R<R>;
+        }
+
+    case 0b110:
+        if constexpr (ddd == Encoded_M) {
+            return &CPU::MVI_M_d8;
+        }
+        else {
+            return &CPU::MVI_R_d8<R>;
+        }
+
+    case 0b111:
+        switch (ddd) {
+        case 0: return &CPU::RLC_R<Registers::Register::A>;
+        case 1: return &CPU::RRC_R<Registers::Register::A>;
+        case 2: return &CPU::RAL_R<Registers::Register::A>;
+        case 3: return &CPU::RAR_R<Registers::Register::A>;
+        case 4: return &CPU::DAA;
+        case 5: return &CPU::CMA;
+        case 6: return &CPU::STC;
+        case 7: return &CPU::CMC;
+        }
+        break;
+    }
+
+    return nullptr;
+}
+
+template <uint8_t Opcode>
+consteval CPU::MemberFunction CPU::decodeMOV() {
+    constexpr uint8_t ddd{ (Opcode >> 3) & 0b111 };
+    constexpr uint8_t sss{ Opcode & 0b111 };
+
+    if constexpr (ddd == Encoded_M && sss == Encoded_M) {
+        return &CPU::HLT;
+    }
+    else if constexpr (ddd == Encoded_M) {
+        return &CPU::MOV_M_R<Encoded_Registers[sss]>;
+    }
+    else if constexpr (sss == Encoded_M) {
+        return &CPU::MOV_R_M<Encoded_Registers[ddd]>;
+    }
+    else {
+        return &CPU::MOV_R_R<Encoded_Registers[sss], Encoded_Registers[ddd]>;
+    }
+}
+
+template <uint8_t Opcode>
+consteval CPU::MemberFunction CPU::decodeALU() {
+    constexpr uint8_t operation{ (Opcode >> 3) & 0b111 };
+    constexpr uint8_t sss{ Opcode & 0b111 };
+    constexpr auto R{ Encoded_Registers[sss] };
+
+    if constexpr (sss == Encoded_M) {
+        switch (operation) {
+        case 0: return &CPU::ADD_M;
+        case 1: return &CPU::ADC_M;
+        case 2: return &CPU::SUB_M;
+        case 3: return &CPU::SBB_M;
+        case 4: return &CPU::ANA_M;
+        case 5: return &CPU::XRA_M;
+        case 6: return &CPU::ORA_M;
+        case 7: return &CPU::CMP_M;
+        }
+    }
+    else {
+        switch (operation) {
+        case 0: return &CPU::ADD_R<R>;
+        case 1: return &CPU::ADC_R<R>;
+        case 2: return &CPU::SUB_R<R>;
+        case 3: return &CPU::SBB_R<R>;
+        case 4: return &CPU::ANA_R<R>;
+        case 5: return &CPU::XRA_R<R>;
+        case 6: return &CPU::ORA_R<R>;
+        case 7: return &CPU::CMP_R<R>;
+        }
+    }
+
+    return nullptr;
+}
+
+template <uint8_t Opcode>
+consteval CPU::MemberFunction CPU::decodeControl() {
+    constexpr uint8_t ddd{ (Opcode >> 3) & 0b111 };
+    constexpr uint8_t rp{ (Opcode >> 4) & 0b11 };
+
+    switch (Opcode & 0b111) {
+    case 0b000:
+        return &CPU::Rcc<ddd>;
+
+    case 0b001:
+        if constexpr ((Opcode & 0b1000) == 0) {
+            return &CPU::POP_RR<Encoded_Stack_Pairs[rp]>;
+        }
+        else {
+            // RET, RET (no documentado), PCHL y SPHL
+            switch (rp) {
+            case 0:
+            case 1: return &CPU::RET;
+            case 2: return &CPU::PCHL;
+            case 3: return &CPU::SPHL;
+            }
+        }
+        break;
+
+    case 0b010:
+        return &CPU::Jcc_a16<ddd>;
+
+    case 0b011:
+        switch (ddd) {
+        case 0:
+        case 1: return &CPU::JMP_a16;
+        case 2: return &CPU::OUT_d8;
+        case 3: return &CPU::IN_d8;
+        case 4: return &CPU::XTHL;
+        case 5: return &CPU::XCHG;
+        case 6: return &CPU::DI;
+        case 7: return &CPU::EI;
+        }
+        break;
+
+    case 0b100:
+        return &CPU::Ccc_a16<ddd>;
+
+    case 0b101:
+        if constexpr ((Opcode & 0b1000) == 0) {
+            return &CPU::PUSH_RR<Encoded_Stack_Pairs[rp]>;
+        }
+        else {
+            // CALL y sus tres alias no documentados
+            return &CPU::CALL_a16;
+        }
+
+    case 0b110:
+        switch (ddd) {
+        case 0: return &CPU::ADI_d8;
+        case 1: return &CPU::ACI_d8;
+        case 2: return &CPU::SBI_d8;
+        case 3: return &CPU::SCI_d8;
+        case 4: return &CPU::ANI_d8;
+        case 5: return &CPU::XRI_d8;
+        case 6: return &CPU::ORI_d8;
+        case 7: return &CPU::CPI_d8;
+        }
+        break;
+
+    case 0b111:
+        return &CPU::RST_n<Opcode & 0b00111000>;
+    }
+
+    return nullptr;
+}
+
+template <uint8_t Opcode>
+consteval CPU::ByteOperandFunction CPU::decodeByteOperand() {
+    constexpr uint8_t ddd{ (Opcode >> 3) & 0b111 };
+
+    if constexpr ((Opcode >> 6) == 0b00) {
+        if constexpr (ddd == Encoded_M) {
+            return &CPU::MVI_M;
+        }
+        else {
+            return &CPU::MVI_R<Encoded_Registers[ddd]>;
+        }
+    }
+    else if constexpr (Opcode == 0xD3) {
+        return &CPU::OUT;
+    }
+    else if constexpr (Opcode == 0xDB) {
+        return &CPU::IN;
+    }
+    else {
+        switch (ddd) {
+        case 0: return &CPU::ADI_ACI_SUI_SBI_CPI<AritmeticOperation::ADD, false, true>;
+        case 1: return &CPU::ADI_ACI_SUI_SBI_CPI<AritmeticOperation::ADD, true, true>;
+        case 2: return &CPU::ADI_ACI_SUI_SBI_CPI<AritmeticOperation::SUB, false, true>;
+        case 3: return &CPU::ADI_ACI_SUI_SBI_CPI<AritmeticOperation::SUB, true, true>;
+        case 4: return &CPU::ANI_ORI_XRI<LogicOperation::AND>;
+        case 5: return &CPU::ANI_ORI_XRI<LogicOperation::XOR>;
+        case 6: return &CPU::ANI_ORI_XRI<LogicOperation::OR>;
+        case 7: return &CPU::ADI_ACI_SUI_SBI_CPI<AritmeticOperation::SUB, false, false>;
+        }
+    }
+
+    return nullptr;
+}
+
+template <uint8_t Opcode>
+consteval CPU::WordOperandFunction CPU::decodeWordOperand() {
+    constexpr uint8_t ddd{ (Opcode >> 3) & 0b111 };
+
+    if constexpr ((Opcode >> 6) == 0b00) {
+        switch (Opcode) {
+        case 0x22: return &CPU::SHLD;
+        case 0x2A: return &CPU::LHLD;
+        case 0x32: return &CPU::STA;
+        case 0x3A: return &CPU::LDA;
+        default:   return &CPU::LXI_RR<Encoded_Pairs[(Opcode >> 4) & 0b11]>;
+        }
+    }
+    else {
+        switch (Opcode & 0b111) {
+        case 0b010: return &CPU::Jcc<ddd>;
+        case 0b011: return &CPU::JMP;
+        case 0b100: return &CPU::Ccc<ddd>;
+        case 0b101: return &CPU::CALL;
+        }
+    }
+
+    return nullptr;
+}
+
+consteval std::array<CPU::MemberFunction, CPU::Opcodes_Number> CPU::makeOpcodesTable() {
+    constexpr auto table{ []<size_t... Opcode>(std::index_sequence<Opcode...>) {
+        return std::array<MemberFunction, Opcodes_Number>{ decodeOpcode<Opcode>()... };
+    }(std::make_index_sequence<Opcodes_Number>{}) };
+
+    static_assert(std::ranges::none_of(table, [](MemberFunction handler) { return handler == nullptr; }), "Every opcode must have a handler");
+
+    return table;
+}
+
+inline constexpr std::array<CPU::MemberFunction, CPU::Opcodes_Number> CPU::Opcodes{ CPU::makeOpcodesTable() };
+
+consteval uint8_t CPU::hotStateUsage(uint8_t opcode) {
+    const uint8_t ddd = (opcode >> 3) & 0b111;
+    const uint8_t sss = opcode & 0b111;
+    const uint8_t usesA = (ddd == 7 ? Hot_A : 0);
+
+    switch (opcode >> 6) {
+    case 0b00:
+        switch (sss) {
+        case 0b000: return 0;                                               // NOP
+        case 0b001: return (opcode & 0b1000) == 0 ? Hot_PC : Hot_F;         // LXI / DAD
+        case 0b010: return ((opcode >> 4) < 2 ? 0 : Hot_PC) | Hot_A;        // STAX, LDAX, SHLD, LHLD, STA y LDA
+        case 0b011: return 0;                                               // INX / DCX
+        case 0b100:
+        case 0b101: return Hot_F | usesA;                                   // INR / DCR
+        case 0b110: return Hot_PC | usesA;                                  // MVI
+        default:    return Hot_A | Hot_F;                                   // Rotaciones, DAA, CMA, STC y CMC
+        }
+
+    case 0b01:
+        if (opcode == 0x76) {
+            return Hot_All;                                                 // HLT
+        }
+        return (ddd == 7 || sss == 7) ? Hot_A : 0;                          // MOV
+
+    case 0b10:
+        return Hot_A | Hot_F;                                               // ALU
+
+    default:
+        if ((opcode & 0b1011) == 0b0001) {
+            return (opcode >> 4) == 0xF ? (Hot_A | Hot_F) : 0;              // PUSH / POP
+        }
+        if (opcode == 0xE3 || opcode == 0xEB || opcode == 0xF9) {
+            return 0;                                                       // XTHL, XCHG y SPHL
+        }
+        return Hot_All;
+    }
+}
+
+template <uint8_t Opcode>
+inline uint8_t CPU::execute() {
+    constexpr MemberFunction handler{ Opcodes[Opcode] };
+    return (this->*handler)();
+}
+
+consteval uint8_t CPU::instructionLength(uint8_t opcode) {
+    const uint8_t ddd = (opcode >> 3) & 0b111;
+    const uint8_t sss = opcode & 0b111;
+
+    switch (opcode >> 6) {
+    case 0b00:
+        if (sss == 0b001 && (opcode & 0b1000) == 0) {
+            return 3;                                   // LXI
+        }
+        if (sss == 0b010 && (opcode >> 4) >= 2) {
+            return 3;                                   // SHLD, LHLD, STA y LDA
+        }
+        return sss == 0b110 ? 2 : 1;                    // MVI
+
+    case 0b11:
+        switch (sss) {
+        case 0b010:
+        case 0b100:
+            return 3;                                   // Jcc y Ccc
+        case 0b011:
+            return ddd < 2 ? 3 : (ddd < 4 ? 2 : 1);     // JMP, OUT e IN
+        case 0b101:
+            return (opcode & 0b1000) != 0 ? 3 : 1;      // CALL
+        case 0b110:
+            return 2;                                   // ALU inmediata
+        default:
+            return 1;
+        }
+
+    default:
+        return 1;                                       // MOV y ALU con registros
+    }
+}
+
+consteval uint8_t CPU::instructionCycles(uint8_t opcode) {
+    const uint8_t ddd = (opcode >> 3) & 0b111;
+    const uint8_t sss = opcode & 0b111;
+    const uint8_t rp = (opcode >> 4) & 0b11;
+    const bool usesM = (ddd == Encoded_M);
+
+    switch (opcode >> 6) {
+    case 0b00:
+        switch (sss) {
+        case 0b000: return NOP_Cycles;
+        case 0b001: return (opcode & 0b1000) == 0 ? LXI_Cycles : DAD_RR_Cycles;
+        case 0b010:
+            if ((opcode & 0b1000) == 0) {
+                return rp < 2 ? STAX_RR_Cycles : (rp == 2 ? SHLD_Cycles : STA_a16_Cycles);
+            }
+            return rp < 2 ? LDAX_RR_Cycles : (rp == 2 ? LHLD_Cycles : LDA_a16_Cycles);
+        case 0b011: return INX_DCX_RR_Cycles;
+        case 0b100:
+        case 0b101: return usesM ? INR_DCR_M_Cycles : INR_DCR_R_Cycles;
+        case 0b110: return usesM ? MVI_M_d8_Cycles : MVI_R_d8_Cycles;
+        default:    return ddd < 4 ? RLC_RRC_RAL_RAR_Cycles : STC_DAA_CMA_CMC_Cycles;
+        }
+
+    case 0b01:
+        if (usesM && sss == Encoded_M) {
+            return HLT_Cycles;                          // HLT
+        }
+        if (usesM) {
+            return MOV_M_R_Cycles;
+        }
+        return sss == Encoded_M ? MOV_R_M_Cycles : MOV_R_R_Cycles;
+
+    case 0b10:
+        if (ddd >= 4 && ddd <= 6) {
+            return sss == Encoded_M ? ANA_ORA_XRA_M_Cycles : ANA_ORA_XRA_R_Cycles;
+        }
+        return sss == Encoded_M ? ADD_ADC_SUB_SBB_CMP_M_Cycles : ADD_ADC_SUB_SBB_CMP_R_Cycles;
+
+    default:
+        switch (sss) {
+        case 0b000: return Rcc_Cycles;
+        case 0b001:
+            if ((opcode & 0b1000) == 0) {
+                return POP_RR_Cycles;
+            }
+            return rp < 2 ? RET_Cycles : (rp == 2 ? PCHL_Cycles : SPHL_Cycles);
+        case 0b010: return Jcc_a16_Cycles;
+        case 0b011:
+            switch (ddd) {
+            case 0:
+            case 1: return JMP_a16_Cycles;
+            case 2:
+            case 3: return IN_OUT_d8_Cycles;
+            case 4: return XTHL_Cycles;
+            case 5: return XCHG_Cycles;
+            default: return EI_DI_Cycles;
+            }
+        case 0b100: return Ccc_a16_Cycles;
+        case 0b101: return (opcode & 0b1000) == 0 ? PUSH_RR_Cycles : CALL_a16_Cycles;
+        case 0b110: return (ddd >= 4 && ddd <= 6) ? ANI_ORI_XRI_d8_Cycles : ADI_ACI_SUI_SBI_CPI_d8_Cycles;
+        default:    return RST_Cycles;
+        }
+    }
+}
+
+inline constexpr std::array<uint8_t, CPU::Opcodes_Number> CPU::Opcodes_Length{
+    []<size_t... Opcode>(std::index_sequence<Opcode...>) {
+        return std::array<uint8_t, Opcodes_Number>{ instructionLength(Opcode)... };
+    }(std::make_index_sequence<Opcodes_Number>{})
+};
+
+inline constexpr std::array<uint8_t, CPU::Opcodes_Number> CPU::Opcodes_Cycles{
+    []<size_t... Opcode>(std::index_sequence<Opcode...>) {
+        return std::array<uint8_t, Opcodes_Number>{ instructionCycles(Opcode)... };
+    }(std::make_index_sequence<Opcodes_Number>{})
+};
+
+template <uint8_t Opcode>
+uint8_t CPU::invoke(CPU& cpu, uint16_t operand) {
+    if constexpr (Opcodes_Length[Opcode] == 2) {
+        constexpr ByteOperandFunction handler{ decodeByteOperand<Opcode>() };
+        static_assert(handler != nullptr, "Every 2-byte opcode must have an operand handler");
+        return (cpu.*handler)(static_cast<uint8_t>(operand));
+    }
+    else if constexpr (Opcodes_Length[Opcode] == 3) {
+        constexpr WordOperandFunction handler{ decodeWordOperand<Opcode>() };
+        static_assert(handler != nullptr, "Every 3-byte opcode must have an operand handler");
+        return (cpu.*handler)(operand);
+    }
+    else {
+        return cpu.execute<Opcode>();
+    }
+}
+
+inline constexpr std::array<DecodeCache::Handler, CPU::Opcodes_Number> CPU::Invokers{
+    []<size_t... Opcode>(std::index_sequence<Opcode...>) {
+        return std::array<DecodeCache::Handler, Opcodes_Number>{ &CPU::invoke<Opcode>... };
+    }(std::make_index_sequence<Opcodes_Number>{})
+};
+
+consteval bool CPU::endsBlock(uint8_t opcode) {
+    if (opcode == 0x76) {
+        return true;                                    // HLT
+    }
+
+    if ((opcode >> 6) != 0b11) {
+        return false;
+    }
+
+    const uint8_t ddd = (opcode >> 3) & 0b111;
+
+    switch (opcode & 0b111) {
+    case 0b000:                                         // Rcc
+    case 0b010:                                         // Jcc
+    case 0b100:                                         // Ccc
+    case 0b111:                                         // RST
+        return true;
+    case 0b001:
+        return opcode == 0xC9 || opcode == 0xD9 || opcode == 0xE9;     // RET y PCHL
+    case 0b011:
+        return ddd < 4 || ddd > 5;                      // JMP, OUT, IN, DI y EI
+    case 0b101:
+        return (opcode & 0b1000) != 0;                  // CALL
+    default:
+        return false;
+    }
+}
+
+constexpr bool CPU::accessesDevices(uint8_t opcode) noexcept {
+    switch (opcode >> 6) {
+    case 0b00:
+        switch (opcode) {
+        case 0x02: case 0x12: case 0x0A: case 0x1A:     // STAX y LDAX
+        case 0x22: case 0x2A: case 0x32: case 0x3A:     // SHLD, LHLD, STA y LDA
+        case 0x34: case 0x35: case 0x36:                // INR M, DCR M y MVI M
+            return true;
+        default:
+            return false;
+        }
+
+    case 0b01:
+        return opcode != 0x76 && ((opcode & 0b111) == Encoded_M || ((opcode >> 3) & 0b111) == Encoded_M);  // MOV con M
+
+    case 0b10:
+        return (opcode & 0b111) == Encoded_M;           // ALU M
+
+    default:
+        switch (opcode & 0b111) {
+        case 0b000:                                     // Rcc
+        case 0b100:                                     // Ccc
+        case 0b101:                                     // PUSH y CALL
+        case 0b111:                                     // RST
+            return true;
+        case 0b001:
+            return opcode != 0xE9 && opcode != 0xF9;    // POP y RET
+        case 0b011:
+            return opcode == 0xD3 || opcode == 0xDB || opcode == 0xE3;     // OUT, IN y XTHL
+        default:
+            return false;
+        }
+    }
+}
+
+constexpr bool CPU::isIdleSafe(uint8_t opcode) noexcept {
+    switch (opcode >> 6) {
+    case 0b00:
+        switch (opcode) {
+        case 0x00:                                      // NOP
+        case 0x07: case 0x0F: case 0x17: case 0x1F:     // Rotaciones
+        case 0x27: case 0x2F: case 0x37: case 0x3F:     // DAA, CMA, STC y CMC
+        case 0x3C: case 0x3D: case 0x3E:                // INR A, DCR A y MVI A
+        case 0x0A: case 0x1A: case 0x3A:                // LDAX y LDA
+            return true;
+        default:
+            return false;
+        }
+
+    case 0b01:
+        return (opcode >> 3) == 0b01111;                // MOV A, r y MOV A, M
+
+    case 0b10:
+        return true;                                    // ALU
+
+    default:
+        return (opcode & 0b111) == 0b110;               // ALU inmediata
+    }
+}
+
+inline constexpr std::array<bool, CPU::Opcodes_Number> CPU::Block_Terminators{
+    []<size_t... Opcode>(std::index_sequence<Opcode...>) {
+        return std::array<bool, Opcodes_Number>{ endsBlock(Opcode)... };
+    }(std::make_index_sequence<Opcodes_Number>{})
+};
+
+inline uint8_t CPU::readMemory(uint16_t address) const {
+    return memory_m.read(address);
+}
+
+inline void CPU::writeMemory(uint16_t address, uint8_t value) {
+    memory_m.write(address, value);
+
+#if defined(FAKE8080_DISPATCH_DECODE_CACHE)
+    decodeCache_m.invalidate(address);
+#endif
+
+#if defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+    codeModified_m |= blockCache_m.invalidate(address);
+#endif
+
+#if defined(FAKE8080_DISPATCH_AOT)
+    if (program_m != nullptr && programCode_m[address]) [[unlikely]] {
+        discardProgramBlocks(address);
+        codeModified_m = true;
+    }
+#endif
+}
+
 #endif // !CPU_HEADER
\ No newline at end of file
@@ -0,0 +1,135 @@
+#ifndef DECODE_CACHE_HEADER
+#define DECODE_CACHE_HEADER
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include "BitsUtilities.hpp"
+
+class CPU;
+
+/// @brief Caché de instrucciones pre-decodificadas indexada por pc, se llena bajo demanda por páginas de 256 bytes
+class DecodeCache {
+public:
+    /// @brief Handler de una instrucción ya resuelto a un puntero a función, recibe el operando pre-decodificado
+    using Handler = uint8_t(*)(CPU&, uint16_t operand);
+
+    /// @brief Instrucción pre-decodificada
+    struct Instruction {
+        Handler handler{ nullptr };
+        uint16_t operand{ 0 };
+
+        /// @brief Bytes que avanza el pc antes de llamar al handler, 0 si no hay instrucción
+        uint8_t length{ 0 };
+    };
+
+    static constexpr uint16_t Page_Size{ 256 };
+    static constexpr uint16_t Pages_Number{ 256 };
+    static constexpr uint8_t Max_Instruction_Length{ 3 };
+
+    /// @brief Busca la instrucción decodificada en una dirección
+    /// @param pc Dirección de la instrucción
+    /// @return Instrucción decodificada o nullptr si no está en caché
+    [[nodiscard]]
+    const Instruction* find(uint16_t pc) const noexcept;
+
+    /// @brief Guarda una instrucción decodificada, reservando su página si hace falta
+    /// @param pc Dirección de la instrucción
+    /// @param instruction Instrucción decodificada
+    /// @return Referencia a la entrada guardada
+    const Instruction& insert(uint16_t pc, const Instruction& instruction);
+
+    /// @brief Invalida las instrucciones cuyo rango de bytes contiene la dirección escrita
+    /// @param address Dirección escrita
+    void invalidate(uint16_t address) noexcept;
+
+    /// @brief Invalida todas las instrucciones de una página
+    /// @param page Número de página (byte alto de la dirección)
+    void invalidatePage(uint8_t page) noexcept;
+
+    /// @brief Vacía la caché
+    void clear() noexcept;
+
+    /// @brief Indica si una página tiene instrucciones decodificadas
+    /// @param page Número de página
+    /// @return true si la página contiene código decodificado
+    [[nodiscard]]
+    bool containsCode(uint8_t page) const noexcept;
+
+private:
+    using Page = std::array<Instruction, Page_Size>;
+
+    std::array<std::unique_ptr<Page>, Pages_Number> pages_m;
+
+    /// @brief Invalida la instrucción en pc si su rango alcanza la dirección escrita
+    /// @param pc Dirección de la instrucción candidata
+    /// @param distance Distancia entre pc y la dirección escrita
+    void invalidateIfCovers(uint16_t pc, uint8_t distance) noexcept;
+};
+
+inline const DecodeCache::Instruction* DecodeCache::find(uint16_t pc) const noexcept {
+    const auto& page{ pages_m[getHighByte(pc)] };
+
+    if (!page) {
+        return nullptr;
+    }
+
+    const auto& instruction{ (*page)[getLowBytes(pc)] };
+    return instruction.length != 0 ? &instruction : nullptr;
+}
+
+inline const DecodeCache::Instruction& DecodeCache::insert(uint16_t pc, const Instruction& instruction) {
+    auto& page{ pages_m[getHighByte(pc)] };
+
+    if (!page) {
+        page = std::make_unique<Page>();
+    }
+
+    auto& entry{ (*page)[getLowBytes(pc)] };
+    entry = instruction;
+
+    return entry;
+}
+
+inline void DecodeCache::invalidate(uint16_t address) noexcept {
+    // Una instrucción de hasta 3 bytes que empiece en address - 2 puede contener la dirección escrita
+    for (uint8_t distance{ 0 }; distance < Max_Instruction_Length; ++distance) {
+        invalidateIfCovers(static_cast<uint16_t>(address - distance), distance);
+    }
+}
+
+inline void DecodeCache::invalidateIfCovers(uint16_t pc, uint8_t distance) noexcept {
+    const auto& page{ pages_m[getHighByte(pc)] };
+
+    if (!page) [[likely]] {
+        return;
+    }
+
+    auto& instruction{ (*page)[getLowBytes(pc)] };
+
+    if (instruction.length > distance) {
+        instruction = Instruction{};
+    }
+}
+
+inline void DecodeCache::invalidatePage(uint8_t page) noexcept {
+    pages_m[page].reset();
+
+    // Las últimas instrucciones de la página anterior pueden extenderse sobre esta
+    const uint16_t pageStart{ static_cast<uint16_t>(page << 8) };
+    for (uint8_t distance{ 1 }; distance < Max_Instruction_Length; ++distance) {
+        invalidateIfCovers(static_cast<uint16_t>(pageStart - distance), distance);
+    }
+}
+
+inline void DecodeCache::clear() noexcept {
+    for (auto& page : pages_m) {
+        page.reset();
+    }
+}
+
+inline bool DecodeCache::containsCode(uint8_t page) const noexcept {
+    return pages_m[page] != nullptr;
+}
+
+#endif // !DECODE_CACHE_HEADER
@@ -1,21 +1,82 @@
 #ifndef FAKE_8080_HEADER
 #define FAKE_8080_HEADER
 
+#include <array>
 #include <cstdint>
-#include <fstream>
-#include <vector>
+#include <memory>
+#include <span>
 #include <string_view>
+#include <vector>
 #include "CPU.hpp"
+#include "RomImage.hpp"
 
 class Fake8080 {
 public:
+    /// @brief Rango de direcciones con RAM privada, de páginas completas
+    struct RamRange {
+        uint16_t first;
+        uint16_t last;
+    };
+
     Fake8080(std::string_view romPath);
 
+    /// @brief Carga varias ROMs una tras otra desde la dirección 0, como los zócalos de una placa, con RAM privada en
+    /// todo lo que queda por encima
+    /// @param romPaths Rutas en orden de dirección, solo la última puede terminar a mitad de una página
+    explicit Fake8080(std::span<const std::string_view> romPaths);
+
+    /// @brief Carga varias ROMs desde la dirección 0 y solo pone RAM privada en los rangos indicados. El resto del
+    /// espacio queda sin conectar: se lee Open_Bus_Value y las escrituras se descartan
+    /// @param romPaths Rutas en orden de dirección, solo la última puede terminar a mitad de una página
+    /// @param ramRanges Rangos en orden de dirección, por encima de las páginas completas de las ROMs
+    Fake8080(std::span<const std::string_view> romPaths, std::span<const RamRange> ramRanges);
+
+    /// @brief CPU de la máquina, para asociar sus dispositivos y ejecutarla
+    [[nodiscard]]
+    CPU& cpu() noexcept {
+        return cpu_m;
+    }
+
+    /// @brief Memoria privada de la instancia, sus rangos uno tras otro desde ramStart()
+    [[nodiscard]]
+    std::span<const uint8_t> ram() const noexcept {
+        return ram_m;
+    }
+
+    /// @brief Primera dirección de la RAM privada
+    [[nodiscard]]
+    uint16_t ramStart() const noexcept {
+        return ramStart_m;
+    }
+
+    /// @brief Tamaño total de las ROMs cargadas
+    [[nodiscard]]
+    size_t romSize() const noexcept {
+        return romSize_m;
+    }
+
 private:
-    std::vector<uint8_t> loadedROM_m;
-    CPU cpu_m;
+    /// @brief Abre las ROMs y acumula su tamaño
+    /// @param romPaths Rutas en orden de dirección
+    void loadROMs(std::span<const std::string_view> romPaths);
+
+    /// @brief Deja el espacio sin conectar y mapea las páginas de las ROMs y los rangos de RAM
+    /// @param ramRanges Rangos de RAM en orden de dirección
+    void mapMemory(std::span<const RamRange> ramRanges);
+
+    /// @brief ROMs compartidas con el resto de instancias que las hayan abierto
+    std::vector<std::shared_ptr<const RomImage>> roms_m;
 
-    void loadRom(std::string_view path);
+    /// @brief Memoria privada de la instancia: sus rangos de RAM uno tras otro
+    std::vector<uint8_t> ram_m;
+
+    /// @brief Última página de las ROMs cuando termina a mitad y no cae en la RAM, el resto se lee como bus abierto
+    std::unique_ptr<std::array<uint8_t, MemoryBus::Page_Size>> romTail_m;
+
+    size_t romSize_m{ 0 };
+    uint16_t ramStart_m{ 0 };
+
+    CPU cpu_m;
 };
 
-#endif // !FAKE_8080_HEADER
\ No newline at end of file
+#endif // !FAKE_8080_HEADER
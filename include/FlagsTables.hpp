@@ -0,0 +1,112 @@
+#ifndef FLAGS_TABLES_HEADER
+#define FLAGS_TABLES_HEADER
+
+#include <array>
+#include <cstdint>
+
+/// @brief Máscaras de cada flag dentro del registro F
+static constexpr uint8_t Flag_S{ 1 << 7 };
+static constexpr uint8_t Flag_Z{ 1 << 6 };
+static constexpr uint8_t Flag_AC{ 1 << 4 };
+static constexpr uint8_t Flag_P{ 1 << 2 };
+static constexpr uint8_t Flag_CY{ 1 << 0 };
+
+/// @brief Flags que modifican las operaciones aritméticas y lógicas de 8 bits
+static constexpr uint8_t Flags_SZACPCY{ Flag_S | Flag_Z | Flag_AC | Flag_P | Flag_CY };
+
+/// @brief S, Z y P de cada resultado de 8 bits
+static constexpr std::array<uint8_t, 256> Flags_SZP{
+    [] {
+        std::array<uint8_t, 256> table{};
+
+        for (uint16_t value{ 0 }; value < table.size(); ++value) {
+            uint8_t bits{ 0 };
+            for (uint8_t i{ 0 }; i < 8; ++i) {
+                bits += (value >> i) & 1;
+            }
+
+            table[value] = static_cast<uint8_t>((value & Flag_S) | (value == 0 ? Flag_Z : 0) | (bits % 2 == 0 ? Flag_P : 0));
+        }
+
+        return table;
+    }()
+};
+
+/// @brief Calcula S, Z, AC, P y CY de una suma o resta de 8 bits
+///
+/// El bit n de first ^ second ^ wide es el acarreo (o préstamo) que entra en el bit n, así que AC sale del
+/// bit 4 y CY del bit 8 del resultado sin truncar. Con la tabla de S, Z y P queda una carga y dos máscaras.
+/// @param first Primer operando
+/// @param second Segundo operando
+/// @param wide Resultado sin truncar: first + second + carry o first - second - carry
+/// @return Flags en sus posiciones de F, el resto de bits a 0
+[[nodiscard]]
+static constexpr uint8_t arithmeticFlags(uint8_t first, uint8_t second, uint32_t wide) noexcept {
+    const auto carries{ first ^ second ^ wide };
+
+    return static_cast<uint8_t>(Flags_SZP[wide & 0xFF] | (carries & Flag_AC) | ((carries >> 8) & Flag_CY));
+}
+
+/// @brief Índice de Daa_Results para un acumulador y el estado de AC y CY
+/// @param accumulator Valor de A
+/// @param auxiliaryCarry Valor de AC
+/// @param carry Valor de CY
+/// @return Índice en la tabla
+[[nodiscard]]
+static constexpr uint16_t daaIndex(uint8_t accumulator, bool auxiliaryCarry, bool carry) noexcept {
+    return static_cast<uint16_t>(carry << 9 | auxiliaryCarry << 8 | accumulator);
+}
+
+/// @brief Resultado de DAA para cada (A, AC, CY): el acumulador ajustado en el byte alto y S, Z, AC, P y CY en el bajo.
+/// AC no cambia y CY solo puede activarse
+static constexpr std::array<uint16_t, 1024> Daa_Results{
+    [] {
+        std::array<uint16_t, 1024> table{};
+
+        for (uint16_t index{ 0 }; index < table.size(); ++index) {
+            auto accumulator{ static_cast<uint8_t>(index) };
+            const bool auxiliaryCarry{ ((index >> 8) & 1) != 0 };
+            bool carry{ ((index >> 9) & 1) != 0 };
+
+            if (auxiliaryCarry || (accumulator & 0x0F) > 9) {
+                accumulator += 0x06;
+            }
+
+            if (carry || (accumulator >> 4) > 9) {
+                accumulator += 0x60;
+                carry = true;
+            }
+
+            const uint8_t flags = Flags_SZP[accumulator] | (auxiliaryCarry ? Flag_AC : 0) | (carry ? Flag_CY : 0);
+            table[index] = static_cast<uint16_t>(accumulator << 8 | flags);
+        }
+
+        return table;
+    }()
+};
+
+/// @brief Número de condiciones de Jcc, Ccc y Rcc
+static constexpr uint8_t Conditions_Number{ 8 };
+
+/// @brief Indica si se cumple cada condición para cada valor de F. La condición es el campo ccc del opcode
+/// (bits 3-5): NZ, Z, NC, C, PO, PE, P y M
+static constexpr std::array<std::array<bool, 256>, Conditions_Number> Conditions_Table{
+    [] {
+        std::array<std::array<bool, 256>, Conditions_Number> table{};
+        constexpr std::array<uint8_t, Conditions_Number / 2> Tested_Flags{ Flag_Z, Flag_CY, Flag_P, Flag_S };
+
+        for (uint8_t condition{ 0 }; condition < Conditions_Number; ++condition) {
+            // Las condiciones pares comprueban que la flag esté a 0 y las impares que esté a 1
+            const auto flag{ Tested_Flags[condition / 2] };
+            const bool expected{ (condition & 1) != 0 };
+
+            for (uint16_t flags{ 0 }; flags < 256; ++flags) {
+                table[condition][flags] = ((flags & flag) != 0) == expected;
+            }
+        }
+
+        return table;
+    }()
+};
+
+#endif // !FLAGS_TABLES_HEADER
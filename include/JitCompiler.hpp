@@ -0,0 +1,79 @@
+#ifndef JIT_COMPILER_HEADER
+#define JIT_COMPILER_HEADER
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "BlockCache.hpp"
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "El JIT solo está disponible en Linux x86-64"
+#endif
+
+class CPU;
+
+/// @brief Estado del 8080 que el código nativo carga en registros de la máquina al entrar en un bloque y vuelca al salir
+struct JitState {
+    /// @brief B, C, D, E, H, L, A y F, en el orden de su codificación en los opcodes
+    std::array<uint8_t, 8> registers;
+    uint16_t sp;
+    uint16_t pc;
+    uint32_t padding;
+
+    CPU* cpu;
+
+    /// @brief Lectura de memoria
+    uint8_t (*read)(CPU& cpu, uint16_t address);
+
+    /// @brief Escritura de memoria, devuelve distinto de 0 si la escritura ha invalidado código traducido
+    uint8_t (*write)(CPU& cpu, uint16_t address, uint8_t value);
+};
+
+/// @brief Compilador de bloques básicos calientes a código x86-64
+///
+/// Los registros del 8080 viven en r8-r15 durante el bloque (B, C, D, E, H, L, A y F) y los flags se obtienen
+/// directamente de RFLAGS, que coinciden bit a bit con los del 8080. Los accesos a memoria llaman a las funciones
+/// de JitState para respetar la invalidación de código. Solo se compila el prefijo del bloque formado por
+/// instrucciones soportadas, el resto lo ejecuta el intérprete.
+class JitCompiler {
+public:
+    /// @brief Ejecuciones de un bloque antes de compilarlo
+    static constexpr uint32_t Hotness_Threshold{ 32 };
+
+    /// @brief Tamaño del buffer de código ejecutable
+    static constexpr size_t Buffer_Size{ 8 * 1024 * 1024 };
+
+    JitCompiler();
+    ~JitCompiler();
+
+    JitCompiler(const JitCompiler&) = delete;
+    JitCompiler& operator=(const JitCompiler&) = delete;
+
+    /// @brief Compila el prefijo soportado de un bloque y lo asigna a block.native
+    /// @param block Bloque a compilar
+    /// @return true si se ha generado código nativo
+    bool compile(BlockCache::Block& block);
+
+    /// @brief Indica si el código generado se puede ejecutar. Deja de poder hacerlo si el sistema niega devolver el
+    /// buffer a ejecutable tras copiar un bloque, y entonces no se compila nada más
+    [[nodiscard]]
+    bool isExecutable() const noexcept {
+        return executable_m;
+    }
+
+    /// @brief Descarta todo el código generado, los bloques que lo referencian deben haberse descartado antes
+    void reset() noexcept;
+
+    /// @brief Indica si el compilador puede traducir un opcode
+    /// @param opcode Opcode a evaluar
+    /// @return true si el opcode está soportado
+    [[nodiscard]]
+    static bool supports(uint8_t opcode) noexcept;
+
+private:
+    uint8_t* buffer_m{ nullptr };
+    size_t used_m{ 0 };
+    bool executable_m{ true };
+};
+
+#endif // !JIT_COMPILER_HEADER
@@ -0,0 +1,391 @@
+#ifndef MEMORY_BUS_HEADER
+#define MEMORY_BUS_HEADER
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+/// @brief Espacio de direcciones completo del 8080
+///
+/// Siempre hay 64 KiB detrás del bus y las direcciones son uint16_t, así que cualquier dirección calculada (SP - 1,
+/// HL + 1...) da la vuelta en 0xFFFF por el propio tipo y los accesos no necesitan comprobar límites.
+///
+/// El espacio se divide en páginas de 256 bytes con un puntero de lectura y otro de escritura cada una. La RAM apunta
+/// ambos a la memoria, la ROM dirige las escrituras a una página de descarte y las páginas de E/S mapeada en memoria
+/// tienen punteros nulos, que desvían el acceso a sus handlers. Las páginas sin conectar leen de una página fija de
+/// Open_Bus_Value y escriben en la de descarte. Por defecto todo es RAM.
+///
+/// Un rango también puede apuntar a un banco externo: cambiar de banco solo reescribe los punteros de sus páginas.
+///
+/// La memoria propia del bus no se reserva hasta que se escribe en una página que la usa: mientras tanto esas páginas
+/// se leen de una página de ceros compartida. Así una máquina que mapea su ROM compartida y su RAM privada como
+/// bancos no reserva nada más
+class MemoryBus {
+public:
+    static constexpr size_t Size{ 0x10000 };
+    static constexpr size_t Page_Size{ 256 };
+    static constexpr size_t Pages_Number{ Size / Page_Size };
+
+    /// @brief Valor que se lee de una página de E/S sin handler de lectura
+    static constexpr uint8_t Open_Bus_Value{ 0xFF };
+
+    /// @brief Handlers de las páginas de E/S, reciben el contexto con el que se mapearon
+    using ReadHandler = uint8_t(*)(void* context, uint16_t address);
+    using WriteHandler = void(*)(void* context, uint16_t address, uint8_t value);
+
+    MemoryBus() {
+        updatePages();
+    }
+
+    MemoryBus(const MemoryBus&) = delete;
+    MemoryBus& operator=(const MemoryBus&) = delete;
+
+    /// @brief Copia una imagen a partir de la dirección 0 de la memoria propia del bus, el resto queda a 0.
+    /// El mapa de páginas se conserva
+    /// @param image Imagen de como mucho 64 KiB
+    void load(std::span<const uint8_t> image) {
+        if (image.size() > Size) {
+            throw std::invalid_argument{ "The image doesn't fit in the 16-bit address space" };
+        }
+
+        if (owned_m) {
+            owned_m->fill(0);
+        }
+        else {
+            owned_m = std::make_unique<std::array<uint8_t, Size>>();
+        }
+
+        std::copy(image.begin(), image.end(), owned_m->begin());
+        memory_m = owned_m->data();
+        updatePages();
+    }
+
+    /// @brief Usa un buffer externo de 64 KiB como memoria, sin copiarlo: las escrituras de la CPU se ven en él.
+    /// El mapa de páginas se conserva
+    /// @param memory Buffer que debe vivir mientras se use el bus
+    void attach(std::span<uint8_t, Size> memory) noexcept {
+        memory_m = memory.data();
+        updatePages();
+    }
+
+    /// @brief Mapea un rango como RAM
+    /// @param first Primera dirección, al inicio de una página
+    /// @param last Última dirección, al final de una página
+    void mapRAM(uint16_t first, uint16_t last) {
+        map(first, last, PageType::RAM, IOHandlers{});
+    }
+
+    /// @brief Mapea un rango como ROM, las escrituras se descartan
+    /// @param first Primera dirección, al inicio de una página
+    /// @param last Última dirección, al final de una página
+    void mapROM(uint16_t first, uint16_t last) {
+        map(first, last, PageType::ROM, IOHandlers{});
+    }
+
+    /// @brief Mapea un rango como E/S, cada acceso llama a su handler
+    /// @param first Primera dirección, al inicio de una página
+    /// @param last Última dirección, al final de una página
+    /// @param read Handler de lectura, sin él se lee Open_Bus_Value
+    /// @param write Handler de escritura, sin él se ignoran las escrituras
+    /// @param context Puntero que se pasa a los handlers
+    void mapIO(uint16_t first, uint16_t last, ReadHandler read, WriteHandler write, void* context) {
+        map(first, last, PageType::IO, IOHandlers{ read, write, context });
+    }
+
+    /// @brief Deja un rango sin nada conectado: se lee Open_Bus_Value y las escrituras se descartan, sin handlers
+    /// ni memoria detrás
+    /// @param first Primera dirección, al inicio de una página
+    /// @param last Última dirección, al final de una página
+    void unmap(uint16_t first, uint16_t last) {
+        map(first, last, PageType::Unmapped, IOHandlers{});
+    }
+
+    /// @brief Hace visible un banco externo en un rango, sin copiarlo. Sirve tanto para mapearlo como para cambiar
+    /// de banco, ya que solo se reescriben los punteros de las páginas del rango
+    /// @param first Primera dirección, al inicio de una página
+    /// @param last Última dirección, al final de una página
+    /// @param bank Memoria del banco, del mismo tamaño que el rango y que debe vivir mientras esté mapeada
+    /// @param writable false para que el banco se comporte como ROM
+    /// @return true si alguna página del rango ha cambiado
+    bool mapBank(uint16_t first, uint16_t last, std::span<uint8_t> bank, bool writable = true) {
+        checkRange(first, last);
+
+        if (bank.size() != static_cast<size_t>(last - first) + 1) {
+            throw std::invalid_argument{ "The bank size doesn't match the mapped range" };
+        }
+
+        const auto type{ writable ? PageType::RAM : PageType::ROM };
+        bool changed{ false };
+
+        for (size_t page{ firstPage(first) }, offset{ 0 }; page <= lastPage(last); ++page, offset += Page_Size) {
+            uint8_t* data{ bank.data() + offset };
+            changed |= pageTypes_m[page] != type || bankPages_m[page] != data;
+
+            pageTypes_m[page] = type;
+            bankPages_m[page] = data;
+            updatePage(page);
+        }
+
+        // Un banco puede tapar páginas de E/S
+        if (hasIO_m) {
+            updateHasIO();
+        }
+
+        return changed;
+    }
+
+    /// @brief Hace visible un banco de solo lectura en un rango, sin copiarlo. Las escrituras se descartan
+    /// @param first Primera dirección, al inicio de una página
+    /// @param last Última dirección, al final de una página
+    /// @param bank Memoria del banco, del mismo tamaño que el rango y que debe vivir mientras esté mapeada
+    /// @return true si alguna página del rango ha cambiado
+    bool mapROMBank(uint16_t first, uint16_t last, std::span<const uint8_t> bank) {
+        // Las páginas de ROM nunca escriben a través de su puntero, las escrituras van a la página de descarte
+        return mapBank(first, last, std::span<uint8_t>{ const_cast<uint8_t*>(bank.data()), bank.size() }, false);
+    }
+
+    /// @brief Indica si el bus ha reservado o recibido su propia memoria de 64 KiB
+    [[nodiscard]]
+    bool hasMemory() const noexcept {
+        return memory_m != nullptr;
+    }
+
+    /// @brief Indica si hay alguna página de E/S mapeada, cuyos handlers pueden ejecutarse en mitad de una instrucción
+    [[nodiscard]]
+    bool hasIO() const noexcept {
+        return hasIO_m;
+    }
+
+    /// @brief Indica si una dirección cae en una página de E/S, cuyas lecturas pueden tener efectos
+    /// @param address Dirección
+    [[nodiscard]]
+    bool isIO(uint16_t address) const noexcept {
+        return pageTypes_m[address >> Page_Shift] == PageType::IO;
+    }
+
+    /// @brief Lee un byte
+    /// @param address Dirección a leer
+    /// @return Byte leído
+    [[nodiscard]]
+    uint8_t read(uint16_t address) const {
+        const auto* page{ readPages_m[address >> Page_Shift] };
+
+        if (page != nullptr) [[likely]] {
+            return page[address & Page_Mask];
+        }
+
+        return readIO(address);
+    }
+
+    /// @brief Escribe un byte
+    /// @param address Dirección a escribir
+    /// @param value Valor a escribir
+    void write(uint16_t address, uint8_t value) {
+        auto* page{ writePages_m[address >> Page_Shift] };
+
+        if (page != nullptr) [[likely]] {
+            page[address & Page_Mask] = value;
+            return;
+        }
+
+        writeIO(address, value);
+    }
+
+    /// @brief Lee un byte a través del mapa de páginas sin llamar a los handlers de E/S, para inspeccionar lo que ve
+    /// la CPU aunque venga de un banco
+    /// @param address Dirección a leer
+    /// @return Byte visible en la dirección, Open_Bus_Value en las páginas de E/S
+    [[nodiscard]]
+    uint8_t peek(uint16_t address) const noexcept {
+        const auto* page{ readPages_m[address >> Page_Shift] };
+        return page != nullptr ? page[address & Page_Mask] : Open_Bus_Value;
+    }
+
+    /// @brief Acceso directo a un byte de la memoria, sin pasar por el mapa de páginas, para inspeccionarla
+    /// @param address Dirección
+    /// @return Referencia al byte
+    [[nodiscard]]
+    uint8_t& operator[](uint16_t address) {
+        if (memory_m == nullptr) {
+            allocateMemory();
+        }
+
+        return memory_m[address];
+    }
+
+    /// @brief Vista de toda la memoria, sin pasar por el mapa de páginas
+    /// @return Los 64 KiB de memoria, a 0 si todavía no se ha reservado
+    [[nodiscard]]
+    std::span<const uint8_t, Size> view() const noexcept {
+        return std::span<const uint8_t, Size>{ memory_m != nullptr ? memory_m : Zero_Memory.data(), Size };
+    }
+
+private:
+    enum class PageType : uint8_t { RAM = 0, ROM, IO, Unmapped };
+
+    struct IOHandlers {
+        ReadHandler read{ nullptr };
+        WriteHandler write{ nullptr };
+        void* context{ nullptr };
+    };
+
+    static constexpr uint8_t Page_Shift{ 8 };
+    static constexpr uint16_t Page_Mask{ Page_Size - 1 };
+
+    /// @brief Contenido de la memoria antes de reservarla
+    static constexpr std::array<uint8_t, Size> Zero_Memory{};
+
+    /// @brief Lo que se lee de una página sin conectar
+    static constexpr std::array<uint8_t, Page_Size> Open_Bus_Page{ [] {
+        std::array<uint8_t, Page_Size> page{};
+        page.fill(Open_Bus_Value);
+        return page;
+    }() };
+
+    std::unique_ptr<std::array<uint8_t, Size>> owned_m;
+
+    /// @brief Memoria en uso: la propia, un buffer externo de 64 KiB o nullptr si aún no hace falta
+    uint8_t* memory_m{ nullptr };
+
+    /// @brief Destino de las escrituras en ROM
+    std::array<uint8_t, Page_Size> discardPage_m{};
+
+    std::array<PageType, Pages_Number> pageTypes_m{};
+    std::array<const uint8_t*, Pages_Number> readPages_m{};
+    std::array<uint8_t*, Pages_Number> writePages_m{};
+    /// @brief Handlers de cada página de E/S, solo se reservan al mapear la primera
+    std::unique_ptr<std::array<IOHandlers, Pages_Number>> ioHandlers_m;
+
+    /// @brief Memoria de cada página mapeada sobre un banco, nullptr si usa la memoria del bus
+    std::array<uint8_t*, Pages_Number> bankPages_m{};
+
+    bool hasIO_m{ false };
+
+    /// @brief Comprueba que un rango cubre páginas completas
+    /// @param first Primera dirección
+    /// @param last Última dirección
+    static void checkRange(uint16_t first, uint16_t last) {
+        if ((first & Page_Mask) != 0 || (last & Page_Mask) != Page_Mask || first > last) {
+            throw std::invalid_argument{ "The range must cover whole 256-byte pages" };
+        }
+    }
+
+    [[nodiscard]]
+    static constexpr size_t firstPage(uint16_t first) noexcept {
+        return static_cast<size_t>(first >> Page_Shift);
+    }
+
+    [[nodiscard]]
+    static constexpr size_t lastPage(uint16_t last) noexcept {
+        return static_cast<size_t>(last >> Page_Shift);
+    }
+
+    /// @brief Cambia el tipo de un rango de páginas
+    /// @param first Primera dirección, al inicio de una página
+    /// @param last Última dirección, al final de una página
+    /// @param type Tipo de las páginas
+    /// @param handlers Handlers de E/S, solo para PageType::IO
+    void map(uint16_t first, uint16_t last, PageType type, const IOHandlers& handlers) {
+        checkRange(first, last);
+
+        for (size_t page{ firstPage(first) }; page <= lastPage(last); ++page) {
+            pageTypes_m[page] = type;
+            bankPages_m[page] = nullptr;
+            updatePage(page);
+
+            if (type == PageType::IO) {
+                if (!ioHandlers_m) {
+                    ioHandlers_m = std::make_unique<std::array<IOHandlers, Pages_Number>>();
+                }
+
+                (*ioHandlers_m)[page] = handlers;
+            }
+        }
+
+        updateHasIO();
+    }
+
+    void updateHasIO() noexcept {
+        hasIO_m = std::find(pageTypes_m.begin(), pageTypes_m.end(), PageType::IO) != pageTypes_m.end();
+    }
+
+    /// @brief Recalcula los punteros de todas las páginas
+    void updatePages() noexcept {
+        for (size_t page{ 0 }; page < Pages_Number; ++page) {
+            updatePage(page);
+        }
+    }
+
+    /// @brief Reserva la memoria propia del bus, a 0
+    void allocateMemory() {
+        owned_m = std::make_unique<std::array<uint8_t, Size>>();
+        memory_m = owned_m->data();
+        updatePages();
+    }
+
+    /// @brief Recalcula los punteros de una página a partir de su tipo y de la memoria que la respalda
+    /// @param page Número de página
+    void updatePage(size_t page) noexcept {
+        uint8_t* data{ bankPages_m[page] };
+
+        if (data == nullptr && memory_m != nullptr) {
+            data = memory_m + page * Page_Size;
+        }
+
+        // Sin memoria las lecturas van a la página de ceros y las escrituras en RAM al camino lento, que la reserva
+        const uint8_t* readData{ data != nullptr ? data : Zero_Memory.data() + page * Page_Size };
+
+        switch (pageTypes_m[page]) {
+        case PageType::RAM:
+            readPages_m[page] = readData;
+            writePages_m[page] = data;
+            break;
+
+        case PageType::ROM:
+            readPages_m[page] = readData;
+            writePages_m[page] = discardPage_m.data();
+            break;
+
+        case PageType::IO:
+            readPages_m[page] = nullptr;
+            writePages_m[page] = nullptr;
+            break;
+
+        case PageType::Unmapped:
+            readPages_m[page] = Open_Bus_Page.data();
+            writePages_m[page] = discardPage_m.data();
+            break;
+        }
+    }
+
+    /// @brief Lectura de una página de E/S
+    /// @param address Dirección a leer
+    /// @return Valor devuelto por el handler
+    [[nodiscard]]
+    uint8_t readIO(uint16_t address) const {
+        const auto& handlers{ (*ioHandlers_m)[address >> Page_Shift] };
+        return handlers.read != nullptr ? handlers.read(handlers.context, address) : Open_Bus_Value;
+    }
+
+    /// @brief Escritura en una página sin puntero de escritura: E/S o RAM cuya memoria aún no se ha reservado
+    /// @param address Dirección a escribir
+    /// @param value Valor a escribir
+    void writeIO(uint16_t address, uint8_t value) {
+        if (pageTypes_m[address >> Page_Shift] == PageType::RAM) {
+            allocateMemory();
+            writePages_m[address >> Page_Shift][address & Page_Mask] = value;
+            return;
+        }
+
+        const auto& handlers{ (*ioHandlers_m)[address >> Page_Shift] };
+
+        if (handlers.write != nullptr) {
+            handlers.write(handlers.context, address, value);
+        }
+    }
+};
+
+#endif // !MEMORY_BUS_HEADER
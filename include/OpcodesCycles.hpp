@@ -59,4 +59,36 @@ static constexpr uint8_t XTHL_Cycles{ 18 };
 
 static constexpr uint8_t XCHG_Cycles{ 5 };
 
+static constexpr uint8_t SPHL_Cycles{ 5 };
+
+static constexpr uint8_t IN_OUT_d8_Cycles{ 10 };
+
+static constexpr uint8_t NOP_Cycles{ 4 };
+
+static constexpr uint8_t JMP_a16_Cycles{ 10 };
+
+static constexpr uint8_t CALL_a16_Cycles{ 17 };
+
+static constexpr uint8_t RET_Cycles{ 10 };
+
+static constexpr uint8_t Jcc_a16_Cycles{ 10 };
+
+/// @brief Ccc y Rcc tardan más cuando se cumple la condición, el resto de tablas guardan el caso sin salto
+static constexpr uint8_t Ccc_a16_Cycles{ 11 };
+
+static constexpr uint8_t Ccc_a16_Taken_Extra_Cycles{ CALL_a16_Cycles - Ccc_a16_Cycles };
+
+static constexpr uint8_t Rcc_Cycles{ 5 };
+
+static constexpr uint8_t Rcc_Taken_Extra_Cycles{ 6 };
+
+static constexpr uint8_t PCHL_Cycles{ 5 };
+
+static constexpr uint8_t RST_Cycles{ 11 };
+
+static constexpr uint8_t EI_DI_Cycles{ 4 };
+
+/// @brief HLT vuelve a ejecutarse mientras la CPU está detenida, cada vuelta cuesta lo mismo
+static constexpr uint8_t HLT_Cycles{ 7 };
+
 #endif // !OPCODES_CYCLES_HEADER
\ No newline at end of file
@@ -0,0 +1,136 @@
+#ifndef PORT_BUS_HEADER
+#define PORT_BUS_HEADER
+
+#include <array>
+#include <cstdint>
+
+/// @brief Puertos de E/S de IN y OUT
+///
+/// Cada configuración de máquina asocia sus 256 puertos de entrada y 256 de salida a handlers de dispositivo en
+/// una tabla plana de punteros a función con su contexto, sin llamadas virtuales ni std::function. Los puertos sin
+/// asociar también tienen handler: los de entrada devuelven el valor de bus abierto y los de salida no hacen nada,
+/// así un acceso es siempre una carga de la tabla y una llamada, sin comprobaciones
+class PortBus {
+public:
+    static constexpr size_t Ports_Number{ 256 };
+
+    /// @brief Valor que se lee de un puerto sin dispositivo si no se configura otro
+    static constexpr uint8_t Default_Open_Bus_Value{ 0xFF };
+
+    /// @brief Handlers de los puertos, reciben el contexto con el que se asociaron
+    using InputHandler = uint8_t(*)(void* context, uint8_t port);
+    using OutputHandler = void(*)(void* context, uint8_t port, uint8_t value);
+
+    PortBus() noexcept {
+        for (size_t port{ 0 }; port < Ports_Number; ++port) {
+            unbindInput(static_cast<uint8_t>(port));
+            unbindOutput(static_cast<uint8_t>(port));
+        }
+    }
+
+    // Los puertos sin asociar apuntan al propio bus
+    PortBus(const PortBus&) = delete;
+    PortBus& operator=(const PortBus&) = delete;
+
+    /// @brief Asocia un puerto de entrada a un handler
+    /// @param port Puerto
+    /// @param handler Handler de lectura
+    /// @param context Puntero que se pasa al handler
+    void bindInput(uint8_t port, InputHandler handler, void* context) noexcept {
+        inputs_m[port] = Input{ handler, context };
+    }
+
+    /// @brief Asocia un puerto de salida a un handler
+    /// @param port Puerto
+    /// @param handler Handler de escritura
+    /// @param context Puntero que se pasa al handler
+    void bindOutput(uint8_t port, OutputHandler handler, void* context) noexcept {
+        outputs_m[port] = Output{ handler, context };
+    }
+
+    /// @brief Asocia un puerto de entrada a un método de un dispositivo, resuelto en tiempo de compilación
+    /// @tparam Method Método uint8_t(uint8_t port) del dispositivo
+    /// @param port Puerto
+    /// @param device Dispositivo, debe vivir mientras esté asociado
+    template<auto Method, typename Device>
+    void bindInput(uint8_t port, Device& device) noexcept {
+        bindInput(port, [](void* context, uint8_t port) -> uint8_t {
+            return (static_cast<Device*>(context)->*Method)(port);
+        }, &device);
+    }
+
+    /// @brief Asocia un puerto de salida a un método de un dispositivo, resuelto en tiempo de compilación
+    /// @tparam Method Método void(uint8_t port, uint8_t value) del dispositivo
+    /// @param port Puerto
+    /// @param device Dispositivo, debe vivir mientras esté asociado
+    template<auto Method, typename Device>
+    void bindOutput(uint8_t port, Device& device) noexcept {
+        bindOutput(port, [](void* context, uint8_t port, uint8_t value) {
+            (static_cast<Device*>(context)->*Method)(port, value);
+        }, &device);
+    }
+
+    /// @brief Deja un puerto de entrada sin dispositivo, se leerá el valor de bus abierto
+    /// @param port Puerto
+    void unbindInput(uint8_t port) noexcept {
+        inputs_m[port] = Input{ &readOpenBus, this };
+    }
+
+    /// @brief Deja un puerto de salida sin dispositivo, sus escrituras se ignoran
+    /// @param port Puerto
+    void unbindOutput(uint8_t port) noexcept {
+        outputs_m[port] = Output{ &ignoreOutput, nullptr };
+    }
+
+    /// @brief Cambia el valor que se lee de los puertos sin dispositivo
+    /// @param value Valor de bus abierto
+    void setOpenBusValue(uint8_t value) noexcept {
+        openBusValue_m = value;
+    }
+
+    [[nodiscard]]
+    uint8_t getOpenBusValue() const noexcept {
+        return openBusValue_m;
+    }
+
+    /// @brief Lee un puerto de entrada
+    /// @param port Puerto
+    /// @return Valor devuelto por el dispositivo
+    [[nodiscard]]
+    uint8_t read(uint8_t port) const {
+        const auto& input{ inputs_m[port] };
+        return input.handler(input.context, port);
+    }
+
+    /// @brief Escribe en un puerto de salida
+    /// @param port Puerto
+    /// @param value Valor a escribir
+    void write(uint8_t port, uint8_t value) {
+        const auto& output{ outputs_m[port] };
+        output.handler(output.context, port, value);
+    }
+
+private:
+    struct Input {
+        InputHandler handler;
+        void* context;
+    };
+
+    struct Output {
+        OutputHandler handler;
+        void* context;
+    };
+
+    std::array<Input, Ports_Number> inputs_m;
+    std::array<Output, Ports_Number> outputs_m;
+
+    uint8_t openBusValue_m{ Default_Open_Bus_Value };
+
+    static uint8_t readOpenBus(void* context, uint8_t) noexcept {
+        return static_cast<const PortBus*>(context)->openBusValue_m;
+    }
+
+    static void ignoreOutput(void*, uint8_t, uint8_t) noexcept {}
+};
+
+#endif // !PORT_BUS_HEADER
@@ -2,14 +2,28 @@
 #define REGISTERS_HEADER
 
 #include <cstdint>
+#include <cstring>
 #include <array>
+#include <bit>
 #include <utility>
 #include "BitsUtilities.hpp"
+#include "FlagsTables.hpp"
+
+#if defined(FAKE8080_LAZY_FLAGS)
+static constexpr bool Lazy_Flags_Enabled{ true };
+#else
+static constexpr bool Lazy_Flags_Enabled{ false };
+#endif
 
 /// @brief Clase que representa los registros de un Intel 8080
+///
+/// Todo el archivo es inline y constexpr: con el registro como constante (los handlers lo reciben como parámetro de
+/// plantilla) el compilador resuelve la posición y las comprobaciones de F y PSW en tiempo de compilación
 class Registers {
 public:
-    Registers();
+    constexpr Registers() noexcept {
+        registers_m[Register_Offsets[std::to_underlying(Register::F)]] = Initial_Flags_Register_Value;
+    }
 
     /// @brief Registros de 8 bits
     enum class Register : uint8_t { A = 0, B, C, D, E, H, L, F, SP_high, SP_low, W, Z };
@@ -24,60 +38,244 @@ public:
     /// @param reg Registro a obtener
     /// @return Valor del registro
     [[nodiscard]]
-    uint8_t getRegister(Register reg) const noexcept;
+    constexpr uint8_t getRegister(Register reg) const noexcept {
+        if constexpr (Lazy_Flags_Enabled) {
+            if (reg == Register::F) {
+                return resolveFlags();
+            }
+        }
+
+        return registers_m[Register_Offsets[std::to_underlying(reg)]];
+    }
 
     /// @brief Obtiene los registros combinado
     /// @param reg Registros a obtener
     /// @return Valor de los registros
     [[nodiscard]]
-    uint16_t getCombinedRegister(CombinedRegister reg) const noexcept;
+    constexpr uint16_t getCombinedRegister(CombinedRegister reg) const noexcept {
+        if constexpr (Lazy_Flags_Enabled) {
+            if (reg == CombinedRegister::PSW) {
+                return static_cast<uint16_t>(getRegister(Register::A) << Byte_Shift | resolveFlags());
+            }
+        }
+
+        return loadPair(reg);
+    }
 
     /// @brief Establece un valor al registro dado
     /// @param reg Registro a establecer
     /// @param value Valor a establecer
-    void setRegister(Register reg, uint8_t value) noexcept;
+    constexpr void setRegister(Register reg, uint8_t value) noexcept {
+        if (reg == Register::F) {
+            replaceFlags(value);
+            return;
+        }
+
+        registers_m[Register_Offsets[std::to_underlying(reg)]] = value;
+    }
 
     /// @brief Establece un valor al par de registros
     /// @param reg Registros a establecer
     /// @param value Valor a establecer
-    void setCombinedRegister(CombinedRegister reg, uint16_t value) noexcept;
+    constexpr void setCombinedRegister(CombinedRegister reg, uint16_t value) noexcept {
+        if (reg == CombinedRegister::PSW) {
+            value |= Fixed_Flags_Bits;
+            discardDeferredFlags();
+        }
+
+        storePair(reg, value);
+    }
 
     /// @brief Obtiene la flag dada
     /// @param flag Flag a obtener
     /// @return Estado del flag
     [[nodiscard]]
-    bool getFlag(Flags flag) const noexcept;
+    constexpr bool getFlag(Flags flag) const noexcept {
+        return getBit(getRegister(Register::F), FlagsShifts[std::to_underlying(flag)]);
+    }
 
     /// @brief Establece el flag al valor dado
     /// @param flag Flag a establecer
     /// @param value Valor a establecer
-    void setFlag(Flags flag, bool value) noexcept;
+    constexpr void setFlag(Flags flag, bool value) noexcept {
+        const auto mask{ static_cast<uint8_t>(1 << FlagsShifts[std::to_underlying(flag)]) };
+        setFlags(mask, value ? mask : 0);
+    }
+
+    /// @brief Establece varias flags con una sola escritura de F, el resto de bits se conservan y el bit 1 sigue a 1
+    /// @param mask Flags a modificar (Flag_S, Flag_Z, Flag_AC, Flag_P y Flag_CY combinadas)
+    /// @param values Nuevos valores en sus posiciones de F, los bits fuera de la máscara se ignoran
+    constexpr void setFlags(uint8_t mask, uint8_t values) noexcept {
+        if constexpr (Lazy_Flags_Enabled) {
+            commitFlags();
+        }
+
+        auto& flags{ registers_m[Register_Offsets[std::to_underlying(Register::F)]] };
+        flags = static_cast<uint8_t>((flags & ~mask) | (values & mask) | Fixed_Flags_Bits);
+    }
+
+    /// @brief Sustituye F completo, descartando la operación pendiente; el bit 1 sigue a 1
+    /// @param flags Nuevo valor de F
+    constexpr void replaceFlags(uint8_t flags) noexcept {
+        discardDeferredFlags();
+        registers_m[Register_Offsets[std::to_underlying(Register::F)]] = flags | Fixed_Flags_Bits;
+    }
+
+    /// @brief Guarda los operandos de una suma o resta de 8 bits para calcular S, Z, AC, P y CY cuando se lean,
+    /// solo con FAKE8080_LAZY_FLAGS
+    /// @param first Primer operando
+    /// @param second Segundo operando
+    /// @param result Resultado de la operación
+    /// @param carry CY de entrada en ADC y SBB
+    /// @param subtraction Indica si la operación es una resta
+    /// @param modifyCarry Indica si la operación modifica CY, INR y DCR lo conservan
+    constexpr void deferArithmeticFlags(uint8_t first, uint8_t second, uint8_t result, bool carry, bool subtraction, bool modifyCarry) noexcept {
+        // INR y DCR conservan el CY de la operación anterior
+        if (!modifyCarry) {
+            commitFlags();
+        }
+
+        deferred_m = DeferredFlags{ subtraction ? DeferredFlags::Operation::Sub : DeferredFlags::Operation::Add, first, second, result, carry, modifyCarry };
+    }
+
+    /// @brief Guarda el resultado de ANA, ORA o XRA para calcular S, Z y P cuando se lean, CY queda a 0,
+    /// solo con FAKE8080_LAZY_FLAGS
+    /// @param result Resultado de la operación
+    /// @param auxiliaryCarry Valor de AC
+    constexpr void deferLogicFlags(uint8_t result, bool auxiliaryCarry) noexcept {
+        deferred_m = DeferredFlags{ DeferredFlags::Operation::Logic, 0, 0, result, auxiliaryCarry, true };
+    }
 
 private:
+    /// @brief Última operación cuyas flags aún no se han calculado
+    struct DeferredFlags {
+        enum class Operation : uint8_t { None = 0, Add, Sub, Logic };
+
+        Operation operation{ Operation::None };
+        uint8_t first{ 0 };
+        uint8_t second{ 0 };
+        uint8_t result{ 0 };
+
+        /// @brief CY de entrada, o AC en las operaciones lógicas
+        bool carry{ false };
+
+        bool modifyCarry{ false };
+    };
+
     static constexpr uint8_t Byte_Shift{ 8 };
     static constexpr uint8_t Register_Number{ 12 };
 
     static constexpr uint8_t Initial_Flags_Register_Value{ 2 };
 
+    /// @brief El bit 1 de F siempre vale 1
+    static constexpr uint8_t Fixed_Flags_Bits{ 0x2 };
+
     static constexpr std::array<uint8_t, 5> FlagsShifts{ 7, 6, 4, 2, 0 };
 
-    static constexpr std::array RegisterPairs {
-        std::pair{Register::B, Register::C},
-        std::pair{Register::D, Register::E},
-        std::pair{Register::H, Register::L},
-        std::pair{Register::SP_high, Register::SP_low},
-        std::pair{Register::W, Register::Z},
-        std::pair{Register::A, Register::F},
+    /// @brief Posición del byte alto y del bajo dentro de cada par, en el orden de bytes de la máquina para que el par
+    /// se lea y escriba como un uint16_t
+    static constexpr uint8_t High_Offset{ std::endian::native == std::endian::little ? 1 : 0 };
+    static constexpr uint8_t Low_Offset{ 1 - High_Offset };
+
+    /// @brief Posición de cada registro de 8 bits dentro de registers_m. Los pares ocupan dos bytes consecutivos en el
+    /// orden de CombinedRegister: BC, DE, HL, SP, WZ y PSW (A y F)
+    static constexpr std::array<uint8_t, Register_Number> Register_Offsets{
+        10 + High_Offset,  // A
+        0 + High_Offset,   // B
+        0 + Low_Offset,    // C
+        2 + High_Offset,   // D
+        2 + Low_Offset,    // E
+        4 + High_Offset,   // H
+        4 + Low_Offset,    // L
+        10 + Low_Offset,   // F
+        6 + High_Offset,   // SP_high
+        6 + Low_Offset,    // SP_low
+        8 + High_Offset,   // W
+        8 + Low_Offset,    // Z
     };
 
-    std::array<uint8_t, Register_Number> registers_m{};
+    alignas(uint16_t) std::array<uint8_t, Register_Number> registers_m{};
+
+    /// @brief Operación pendiente, F conserva los bits que no modifica hasta que se calculan
+    DeferredFlags deferred_m;
+
+    /// @brief Lee un par de registros de registers_m
+    /// @param reg Par a leer
+    /// @return Valor del par
+    [[nodiscard]]
+    constexpr uint16_t loadPair(CombinedRegister reg) const noexcept {
+        const auto offset{ static_cast<size_t>(std::to_underlying(reg)) * 2 };
+
+        if consteval {
+            return static_cast<uint16_t>(registers_m[offset + High_Offset] << Byte_Shift | registers_m[offset + Low_Offset]);
+        }
+        else {
+            uint16_t value;
+            std::memcpy(&value, &registers_m[offset], sizeof(value));
+            return value;
+        }
+    }
+
+    /// @brief Escribe un par de registros en registers_m
+    /// @param reg Par a escribir
+    /// @param value Valor a escribir
+    constexpr void storePair(CombinedRegister reg, uint16_t value) noexcept {
+        const auto offset{ static_cast<size_t>(std::to_underlying(reg)) * 2 };
+
+        if consteval {
+            registers_m[offset + High_Offset] = getHighByte(value);
+            registers_m[offset + Low_Offset] = getLowBytes(value);
+        }
+        else {
+            std::memcpy(&registers_m[offset], &value, sizeof(value));
+        }
+    }
+
+    /// @brief Olvida la operación pendiente al escribir F directamente
+    constexpr void discardDeferredFlags() noexcept {
+        if constexpr (Lazy_Flags_Enabled) {
+            deferred_m.operation = DeferredFlags::Operation::None;
+        }
+    }
 
-    /// @brief Combina dos registros en uno de 16 bits
-    /// @param high Byte alto
-    /// @param low Byte bajo
-    /// @return Valor de 16 bits combinado
+    /// @brief Calcula F a partir de la operación pendiente sin modificarla
+    /// @return Valor de F
     [[nodiscard]]
-    uint16_t combineRegisters(Register high, Register low) const noexcept;
+    constexpr uint8_t resolveFlags() const noexcept {
+        const auto flags{ registers_m[Register_Offsets[std::to_underlying(Register::F)]] };
+        const auto& [operation, first, second, result, carry, modifyCarry] = deferred_m;
+
+        uint8_t computed{ 0 };
+
+        switch (operation) {
+        case DeferredFlags::Operation::None:
+            return flags;
+
+        case DeferredFlags::Operation::Add:
+            computed = arithmeticFlags(first, second, static_cast<uint32_t>(first + second + carry));
+            break;
+
+        case DeferredFlags::Operation::Sub:
+            computed = arithmeticFlags(first, second, static_cast<uint32_t>(first - second - carry));
+            break;
+
+        case DeferredFlags::Operation::Logic:
+            computed = Flags_SZP[result] | (carry ? Flag_AC : 0);
+            break;
+        }
+
+        const uint8_t mask = modifyCarry ? Flags_SZACPCY : Flags_SZACPCY & ~Flag_CY;
+
+        return static_cast<uint8_t>((flags & ~mask) | (computed & mask));
+    }
+
+    /// @brief Vuelca la operación pendiente en F
+    constexpr void commitFlags() noexcept {
+        if (deferred_m.operation != DeferredFlags::Operation::None) {
+            registers_m[Register_Offsets[std::to_underlying(Register::F)]] = resolveFlags();
+            deferred_m.operation = DeferredFlags::Operation::None;
+        }
+    }
 };
 
-#endif // !REGISTERS_HEADER
\ No newline at end of file
+#endif // !REGISTERS_HEADER
@@ -0,0 +1,69 @@
+#ifndef ROM_IMAGE_HEADER
+#define ROM_IMAGE_HEADER
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/// @brief Imagen de ROM de solo lectura compartida por todas las instancias del proceso
+///
+/// Los ficheros regulares se proyectan en memoria con mmap, así que abrir la misma ROM desde miles de instancias no
+/// copia nada. Lo que no se puede proyectar (tuberías, dispositivos, sistemas sin mmap) se lee por bloques grandes.
+/// Las imágenes se registran por el hash de su contenido, de modo que la misma ROM abierta desde rutas distintas
+/// también es una única imagen. Se asume que el fichero no cambia mientras haya alguna instancia que lo use
+class RomImage {
+public:
+    /// @brief Tamaño de los bloques de la lectura por streaming
+    static constexpr size_t Read_Block_Size{ 64 * 1024 };
+
+    /// @brief Abre una ROM, reutilizando la imagen si otra instancia ya la tiene abierta
+    /// @param path Ruta del fichero
+    /// @return Imagen compartida
+    [[nodiscard]]
+    static std::shared_ptr<const RomImage> open(std::string_view path);
+
+    RomImage(const RomImage&) = delete;
+    RomImage& operator=(const RomImage&) = delete;
+
+    ~RomImage();
+
+    /// @brief Contenido de la imagen
+    /// @return Bytes de la ROM
+    [[nodiscard]]
+    std::span<const uint8_t> data() const noexcept {
+        return mapped_m != nullptr ? std::span<const uint8_t>{ mapped_m, mappedSize_m } : std::span<const uint8_t>{ buffer_m };
+    }
+
+    /// @brief Hash FNV-1a del contenido, el mismo que usa AotProgram
+    [[nodiscard]]
+    uint64_t hash() const noexcept {
+        return hash_m;
+    }
+
+    /// @brief Indica si la imagen está proyectada en memoria o se ha leído a un buffer
+    [[nodiscard]]
+    bool isMapped() const noexcept {
+        return mapped_m != nullptr;
+    }
+
+private:
+    RomImage() = default;
+
+    const uint8_t* mapped_m{ nullptr };
+    size_t mappedSize_m{ 0 };
+
+    /// @brief Contenido leído por streaming cuando no se puede proyectar
+    std::vector<uint8_t> buffer_m;
+
+    uint64_t hash_m{ 0 };
+
+    /// @brief Carga el fichero sin pasar por la caché del proceso
+    /// @param path Ruta del fichero
+    /// @return Imagen cargada
+    [[nodiscard]]
+    static std::shared_ptr<RomImage> load(std::string_view path);
+};
+
+#endif // !ROM_IMAGE_HEADER
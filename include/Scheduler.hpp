@@ -0,0 +1,284 @@
+#ifndef SCHEDULER_HEADER
+#define SCHEDULER_HEADER
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/// @brief Planificador de eventos de dispositivos con marca de tiempo en ciclos
+///
+/// Montículo binario de mínimos indexado: cada evento conserva su posición en el montículo, así que programar,
+/// cancelar y reprogramar cuestan O(log n). Los eventos con el mismo plazo se disparan en el orden en que se
+/// programaron, para que la emulación sea determinista
+class Scheduler {
+public:
+    /// @brief Identificador de un evento, válido hasta que se dispara sin reprogramarse o se cancela
+    using EventId = uint32_t;
+
+    /// @brief Callback de un evento, recibe el contexto con el que se programó y el plazo que tenía
+    using Callback = void(*)(void* context, uint64_t deadline);
+
+    /// @brief Plazo cuando no hay eventos pendientes
+    static constexpr uint64_t No_Deadline{ std::numeric_limits<uint64_t>::max() };
+
+    /// @brief Programa un evento
+    /// @param deadline Ciclo en el que debe dispararse
+    /// @param callback Función a llamar
+    /// @param context Puntero que se pasa al callback
+    /// @return Identificador del evento
+    EventId schedule(uint64_t deadline, Callback callback, void* context);
+
+    /// @brief Cancela un evento pendiente
+    /// @param id Evento a cancelar
+    /// @return true si el evento estaba pendiente
+    bool cancel(EventId id) noexcept;
+
+    /// @brief Cambia el plazo de un evento pendiente, o vuelve a programar el que se está disparando desde su callback
+    /// @param id Evento a reprogramar
+    /// @param deadline Nuevo plazo
+    /// @return true si el evento seguía activo, un identificador ya disparado o cancelado no se toca
+    bool reschedule(EventId id, uint64_t deadline);
+
+    /// @brief Indica si un evento sigue pendiente
+    /// @param id Evento
+    [[nodiscard]]
+    bool isPending(EventId id) const noexcept;
+
+    /// @brief Plazo del próximo evento
+    /// @return Ciclo del evento más próximo o No_Deadline si no hay ninguno
+    [[nodiscard]]
+    uint64_t nextDeadline() const noexcept {
+        return heap_m.empty() ? No_Deadline : events_m[heap_m.front()].deadline;
+    }
+
+    /// @brief Dispara en orden todos los eventos cuyo plazo ha llegado, incluidos los que programen sus callbacks
+    /// @param now Ciclo actual
+    /// @return Número de eventos disparados
+    size_t runDue(uint64_t now);
+
+    /// @brief Asocia la porción de ejecución en curso, que se acorta si se programa un evento antes de su final
+    /// @param start Ciclo en que empieza la porción
+    /// @param budget Ciclos de la porción contados desde start, debe seguir vivo hasta endSlice
+    void beginSlice(uint64_t start, uint64_t* budget) noexcept {
+        sliceStart_m = start;
+        sliceBudget_m = budget;
+    }
+
+    /// @brief Termina la porción en curso
+    void endSlice() noexcept {
+        sliceBudget_m = nullptr;
+    }
+
+private:
+    static constexpr uint32_t Not_In_Heap{ std::numeric_limits<uint32_t>::max() };
+
+    struct Event {
+        uint64_t deadline{ 0 };
+        uint64_t sequence{ 0 };
+        Callback callback{ nullptr };
+        void* context{ nullptr };
+        uint32_t heapIndex{ Not_In_Heap };
+        bool active{ false };
+    };
+
+    std::vector<Event> events_m;
+    std::vector<EventId> freeEvents_m;
+
+    /// @brief Identificadores de los eventos pendientes ordenados como montículo por (plazo, secuencia)
+    std::vector<EventId> heap_m;
+
+    uint64_t nextSequence_m{ 0 };
+
+    /// @brief Porción de ejecución en curso, nullptr fuera de ella
+    uint64_t sliceStart_m{ 0 };
+    uint64_t* sliceBudget_m{ nullptr };
+
+    [[nodiscard]]
+    bool precedes(EventId first, EventId second) const noexcept {
+        const auto& a{ events_m[first] };
+        const auto& b{ events_m[second] };
+        return a.deadline != b.deadline ? a.deadline < b.deadline : a.sequence < b.sequence;
+    }
+
+    /// @brief Inserta un evento en el montículo con la siguiente secuencia
+    void push(EventId id);
+
+    /// @brief Saca un evento del montículo sin liberarlo
+    void remove(EventId id) noexcept;
+    void place(uint32_t index, EventId id) noexcept;
+    void siftUp(uint32_t index) noexcept;
+    void siftDown(uint32_t index) noexcept;
+    void release(EventId id);
+};
+
+inline Scheduler::EventId Scheduler::schedule(uint64_t deadline, Callback callback, void* context) {
+    EventId id;
+
+    if (freeEvents_m.empty()) {
+        id = static_cast<EventId>(events_m.size());
+        events_m.emplace_back();
+    }
+    else {
+        id = freeEvents_m.back();
+        freeEvents_m.pop_back();
+    }
+
+    auto& event{ events_m[id] };
+    event.deadline = deadline;
+    event.callback = callback;
+    event.context = context;
+    event.active = true;
+
+    push(id);
+    return id;
+}
+
+inline bool Scheduler::cancel(EventId id) noexcept {
+    if (id >= events_m.size() || !events_m[id].active) {
+        return false;
+    }
+
+    const bool pending{ events_m[id].heapIndex != Not_In_Heap };
+
+    if (pending) {
+        remove(id);
+    }
+
+    // Un evento cancelado desde su propio callback se libera al volver de él
+    events_m[id].active = false;
+
+    if (pending) {
+        freeEvents_m.push_back(id);
+    }
+
+    return pending;
+}
+
+inline bool Scheduler::reschedule(EventId id, uint64_t deadline) {
+    // Un identificador liberado puede estar ya en freeEvents_m o pertenecer a otro evento
+    if (id >= events_m.size() || !events_m[id].active) {
+        return false;
+    }
+
+    auto& event{ events_m[id] };
+
+    if (event.heapIndex != Not_In_Heap) {
+        remove(id);
+    }
+
+    event.deadline = deadline;
+    push(id);
+    return true;
+}
+
+inline bool Scheduler::isPending(EventId id) const noexcept {
+    return id < events_m.size() && events_m[id].active && events_m[id].heapIndex != Not_In_Heap;
+}
+
+inline size_t Scheduler::runDue(uint64_t now) {
+    size_t fired{ 0 };
+
+    while (!heap_m.empty() && events_m[heap_m.front()].deadline <= now) {
+        const auto id{ heap_m.front() };
+        remove(id);
+
+        // El callback puede programar eventos nuevos y mover events_m
+        const auto event{ events_m[id] };
+        event.callback(event.context, event.deadline);
+        ++fired;
+
+        // Si el callback no lo ha reprogramado el evento termina aquí
+        if (events_m[id].heapIndex == Not_In_Heap) {
+            release(id);
+        }
+    }
+
+    return fired;
+}
+
+inline void Scheduler::push(EventId id) {
+    events_m[id].sequence = nextSequence_m++;
+
+    const auto index{ static_cast<uint32_t>(heap_m.size()) };
+    heap_m.push_back(id);
+    events_m[id].heapIndex = index;
+    siftUp(index);
+
+    // Un evento que vence dentro de la porción en curso la corta en su plazo
+    if (sliceBudget_m != nullptr) [[unlikely]] {
+        const auto deadline{ events_m[id].deadline };
+        *sliceBudget_m = std::min(*sliceBudget_m, deadline > sliceStart_m ? deadline - sliceStart_m : 0);
+    }
+}
+
+inline void Scheduler::remove(EventId id) noexcept {
+    const auto index{ events_m[id].heapIndex };
+    const auto last{ heap_m.back() };
+    heap_m.pop_back();
+    events_m[id].heapIndex = Not_In_Heap;
+
+    if (last == id) {
+        return;
+    }
+
+    place(index, last);
+    siftUp(index);
+    siftDown(events_m[last].heapIndex);
+}
+
+inline void Scheduler::place(uint32_t index, EventId id) noexcept {
+    heap_m[index] = id;
+    events_m[id].heapIndex = index;
+}
+
+inline void Scheduler::siftUp(uint32_t index) noexcept {
+    const auto id{ heap_m[index] };
+
+    while (index > 0) {
+        const auto parent{ (index - 1) / 2 };
+
+        if (!precedes(id, heap_m[parent])) {
+            break;
+        }
+
+        place(index, heap_m[parent]);
+        index = parent;
+    }
+
+    place(index, id);
+}
+
+inline void Scheduler::siftDown(uint32_t index) noexcept {
+    const auto id{ heap_m[index] };
+    const auto size{ static_cast<uint32_t>(heap_m.size()) };
+
+    for (;;) {
+        auto child{ 2 * index + 1 };
+
+        if (child >= size) {
+            break;
+        }
+
+        if (child + 1 < size && precedes(heap_m[child + 1], heap_m[child])) {
+            ++child;
+        }
+
+        if (!precedes(heap_m[child], id)) {
+            break;
+        }
+
+        place(index, heap_m[child]);
+        index = child;
+    }
+
+    place(index, id);
+}
+
+inline void Scheduler::release(EventId id) {
+    // También llegan aquí los cancelados desde su propio callback, que cancel no libera
+    events_m[id].active = false;
+    freeEvents_m.push_back(id);
+}
+
+#endif // !SCHEDULER_HEADER
@@ -0,0 +1,107 @@
+#ifndef SPACE_INVADERS_MACHINE_HEADER
+#define SPACE_INVADERS_MACHINE_HEADER
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "Fake8080.hpp"
+
+/// @brief Placa 8080 de Taito de Space Invaders, sin vídeo ni sonido
+///
+/// Cuatro ROMs de 2 KiB desde 0x0000, RAM de trabajo y de vídeo en 0x2000-0x3FFF, el registro de desplazamiento
+/// hardware de los puertos 2, 3 y 4 y los puertos de entrada de los mandos. El barrido de pantalla solo se modela
+/// como las dos interrupciones que lo marcan: RST 1 a mitad de pantalla y RST 2 en el VBlank, programadas en el
+/// planificador. La máquina corre tan rápido como pueda, sin limitarse a 60 frames por segundo. Por encima de la RAM
+/// no hay nada conectado: se lee Open_Bus_Value y las escrituras se pierden
+class SpaceInvadersMachine : public Fake8080 {
+public:
+    static constexpr uint64_t Clock_Frequency{ 2'000'000 };
+    static constexpr uint64_t Frames_Per_Second{ 60 };
+    static constexpr uint64_t Cycles_Per_Frame{ Clock_Frequency / Frames_Per_Second };
+
+    /// @brief Ciclo del frame en el que el haz llega a la mitad de la pantalla
+    static constexpr uint64_t Mid_Screen_Cycles{ Cycles_Per_Frame / 2 };
+
+    static constexpr uint8_t Mid_Screen_Interrupt{ 1 };
+    static constexpr uint8_t VBlank_Interrupt{ 2 };
+
+    static constexpr uint16_t RAM_Start{ 0x2000 };
+    static constexpr uint16_t RAM_End{ 0x3FFF };
+    static constexpr uint16_t Video_RAM_Start{ 0x2400 };
+    static constexpr uint16_t Video_RAM_Size{ 0x1C00 };
+
+    /// @brief Nombres habituales de las ROMs, en orden de dirección
+    static constexpr std::array<std::string_view, 4> Rom_Names{ "invaders.h", "invaders.g", "invaders.f", "invaders.e" };
+
+    /// @brief Mandos de la recreativa, cada uno es un bit de los puertos de entrada 1 o 2
+    enum class Input : uint8_t {
+        Coin, Player1Start, Player2Start, Player1Fire, Player1Left, Player1Right, Player2Fire, Player2Left, Player2Right, Tilt
+    };
+
+    /// @param romPaths Las cuatro ROMs en orden de dirección, como Rom_Names
+    explicit SpaceInvadersMachine(std::span<const std::string_view> romPaths);
+
+    // Los puertos y los eventos apuntan a la propia máquina
+    SpaceInvadersMachine(const SpaceInvadersMachine&) = delete;
+    SpaceInvadersMachine& operator=(const SpaceInvadersMachine&) = delete;
+
+    /// @brief Pulsa o suelta un mando
+    /// @param input Mando
+    /// @param pressed true mientras está pulsado
+    void setInput(Input input, bool pressed) noexcept;
+
+    /// @brief Cambia los interruptores DIP del puerto 2: vidas (bits 0 y 1), vida extra (bit 3) e información de las
+    /// monedas (bit 7)
+    /// @param switches Valor de los interruptores, el resto de bits se ignora
+    void setDipSwitches(uint8_t switches) noexcept;
+
+    /// @brief Ejecuta hasta el siguiente VBlank
+    void runFrame();
+
+    /// @brief Frames completados, es decir, VBlanks atendidos
+    [[nodiscard]]
+    uint64_t getFrames() const noexcept {
+        return frames_m;
+    }
+
+    /// @brief Memoria de vídeo: 256 x 224 píxeles de 1 bit, por columnas de abajo a arriba
+    [[nodiscard]]
+    std::span<const uint8_t> videoRAM() const noexcept {
+        return ram().subspan(Video_RAM_Start - ramStart(), Video_RAM_Size);
+    }
+
+private:
+    static constexpr uint8_t Dip_Switches_Mask{ 0b1000'1011 };
+
+    /// @brief Única RAM de la placa, el resto del espacio por encima de las ROMs queda sin conectar
+    static constexpr std::array<RamRange, 1> Ram_Ranges{ { { RAM_Start, RAM_End } } };
+
+    /// @brief Bits de los puertos de entrada que siempre están a 1
+    static constexpr uint8_t Port0_Fixed_Bits{ 0b0000'1110 };
+    static constexpr uint8_t Port1_Fixed_Bits{ 0b0000'1000 };
+
+    uint8_t port1_m{ Port1_Fixed_Bits };
+    uint8_t port2Inputs_m{ 0 };
+    uint8_t dipSwitches_m{ 0 };
+
+    /// @brief Registro de desplazamiento: OUT 4 mete un byte por arriba y IN 3 lee 8 bits desde el desplazamiento
+    /// que fija OUT 2
+    uint16_t shiftRegister_m{ 0 };
+    uint8_t shiftOffset_m{ 0 };
+
+    uint64_t frames_m{ 0 };
+
+    Scheduler::EventId midScreenEvent_m{ 0 };
+    Scheduler::EventId vblankEvent_m{ 0 };
+
+    uint8_t readInputs(uint8_t port);
+    uint8_t readShiftRegister(uint8_t port);
+    void writeShiftOffset(uint8_t port, uint8_t value);
+    void writeShiftData(uint8_t port, uint8_t value);
+
+    static void midScreen(void* context, uint64_t deadline);
+    static void vblank(void* context, uint64_t deadline);
+};
+
+#endif // !SPACE_INVADERS_MACHINE_HEADER
@@ -0,0 +1,196 @@
+#include "AotCompiler.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include "AotProgram.hpp"
+#include "CPU.hpp"
+
+/// @brief Formatea un valor en hexadecimal con el prefijo 0x
+/// @param value Valor a formatear
+/// @param digits Dígitos mínimos
+/// @return Texto del valor
+static std::string hex(uint32_t value, int digits) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "0x%0*X", digits, value);
+
+    return buffer;
+}
+
+AotCompiler::AotCompiler(std::span<const uint8_t> rom) : rom_m{ rom.first(std::min<size_t>(rom.size(), 0x10000)) } {
+}
+
+void AotCompiler::analyze(std::span<const uint16_t> entryPoints) {
+    std::vector<uint16_t> pending{ entryPoints.begin(), entryPoints.end() };
+
+    while (!pending.empty()) {
+        const auto start{ pending.back() };
+        pending.pop_back();
+
+        if (start >= rom_m.size() || blocks_m.contains(start)) {
+            continue;
+        }
+
+        auto block{ translate(start) };
+
+        if (block.instructions.empty()) {
+            continue;
+        }
+
+        pending.insert(pending.end(), block.successors.begin(), block.successors.end());
+        blocks_m.emplace(start, std::move(block));
+    }
+}
+
+const std::map<uint16_t, AotCompiler::Block>& AotCompiler::blocks() const noexcept {
+    return blocks_m;
+}
+
+bool AotCompiler::writesMemory(uint8_t opcode) noexcept {
+    switch (opcode) {
+    case 0x02:                  // STAX B
+    case 0x12:                  // STAX D
+    case 0x22:                  // SHLD
+    case 0x32:                  // STA
+    case 0x34:                  // INR M
+    case 0x35:                  // DCR M
+    case 0x36:                  // MVI M
+    case 0xC5:                  // PUSH B
+    case 0xD5:                  // PUSH D
+    case 0xE5:                  // PUSH H
+    case 0xF5:                  // PUSH PSW
+    case 0xE3:                  // XTHL
+        return true;
+    default:
+        return (opcode & 0b11111000) == 0b01110000 && opcode != 0x76;     // MOV M, R
+    }
+}
+
+AotCompiler::Block AotCompiler::translate(uint16_t start) const {
+    Block block;
+    block.start = start;
+
+    uint32_t address{ start };
+    uint32_t cycles{ 0 };
+    uint8_t opcode{ 0 };
+
+    // Solo se traduce el código de la imagen, lo que quede fuera lo ejecuta el intérprete
+    while (address < rom_m.size()) {
+        opcode = rom_m[address];
+
+        if (address + CPU::Opcodes_Length[opcode] > rom_m.size()) {
+            break;
+        }
+
+        block.bodyCycles = cycles;
+        cycles += CPU::Opcodes_Cycles[opcode];
+        block.instructions.push_back(Instruction{ static_cast<uint16_t>(address), opcode, cycles });
+        address += CPU::Opcodes_Length[opcode];
+
+        if (CPU::Block_Terminators[opcode]) {
+            block.terminated = true;
+            break;
+        }
+
+        if (block.instructions.size() == BlockCache::Max_Block_Instructions) {
+            break;
+        }
+    }
+
+    block.end = address;
+
+    if (block.instructions.empty()) {
+        return block;
+    }
+
+    const auto next{ address };
+
+    if (!block.terminated) {
+        if (next < rom_m.size()) {
+            block.successors.push_back(static_cast<uint16_t>(next));
+        }
+
+        return block;
+    }
+
+    // Las llamadas y los RST también continúan en la instrucción siguiente cuando retornan
+    const bool unconditional{ opcode == 0xC3 || opcode == 0xCB || opcode == 0xC9 || opcode == 0xD9 || opcode == 0xE9 };
+
+    if (CPU::Opcodes_Length[opcode] == 3) {
+        block.successors.push_back(static_cast<uint16_t>(rom_m[address - 1] << 8 | rom_m[address - 2]));    // JMP, Jcc, CALL y Ccc
+    }
+    else if ((opcode & 0b11000111) == 0b11000111) {
+        block.successors.push_back(opcode & 0b00111000);                                                    // RST
+    }
+
+    if (!unconditional && next < rom_m.size()) {
+        block.successors.push_back(static_cast<uint16_t>(next));
+    }
+
+    return block;
+}
+
+void AotCompiler::emit(std::ostream& output, std::string_view symbol) const {
+    output << "// Generado por fake8080_aot, no editar\n";
+    output << "#include \"AotRuntime.hpp\"\n";
+
+    for (const auto& [start, block] : blocks_m) {
+        output << '\n';
+        emitBlock(output, block);
+    }
+
+    output << "\nstatic constexpr AotProgram::Block Blocks[]{\n";
+
+    for (const auto& [start, block] : blocks_m) {
+        const bool accessesMemory{ std::any_of(block.instructions.begin(), block.instructions.end() - 1, [](const auto& instruction) {
+            return CPU::accessesDevices(instruction.opcode);
+        }) };
+
+        output << "    { " << hex(block.start, 4) << ", " << hex(block.end, 4) << ", " << block.bodyCycles << ", "
+               << (accessesMemory ? "true" : "false") << ", &block_" << hex(block.start, 4).substr(2) << " },\n";
+    }
+
+    output << "};\n\n";
+    output << "extern const AotProgram " << symbol << ";\n";
+    output << "const AotProgram " << symbol << "{ Blocks, " << rom_m.size() << ", " << AotProgram::hash(rom_m) << "ull };\n";
+}
+
+void AotCompiler::emitBlock(std::ostream& output, const Block& block) const {
+    output << "static uint32_t block_" << hex(block.start, 4).substr(2) << "(CPU& cpu) {\n";
+
+    const auto last{ block.instructions.size() - 1 };
+
+    for (size_t index{ 0 }; index < block.instructions.size(); ++index) {
+        const auto& instruction{ block.instructions[index] };
+        const auto length{ CPU::Opcodes_Length[instruction.opcode] };
+        const auto next{ static_cast<uint16_t>(instruction.address + length) };
+        const auto opcode{ hex(instruction.opcode, 2) };
+
+        // El terminador calcula el pc siguiente y sus ciclos reales, como en los demás backends
+        if (index == last && block.terminated) {
+            output << "    AotRuntime::setPC(cpu, " << hex(static_cast<uint16_t>(instruction.address + 1), 4) << ");\n";
+            output << "    return " << block.bodyCycles << " + AotRuntime::execute<" << opcode << ">(cpu);\n";
+            break;
+        }
+
+        // Solo las instrucciones con operandos leen el pc
+        if (length > 1) {
+            output << "    AotRuntime::setPC(cpu, " << hex(static_cast<uint16_t>(instruction.address + 1), 4) << ");\n";
+        }
+
+        output << "    AotRuntime::execute<" << opcode << ">(cpu);\n";
+
+        if (writesMemory(instruction.opcode)) {
+            output << "    if (AotRuntime::codeModified(cpu)) [[unlikely]] {\n";
+            output << "        AotRuntime::setPC(cpu, " << hex(next, 4) << ");\n";
+            output << "        return " << instruction.cyclesUntil << ";\n";
+            output << "    }\n";
+        }
+
+        if (index == last) {
+            output << "    AotRuntime::setPC(cpu, " << hex(static_cast<uint16_t>(block.end), 4) << ");\n";
+            output << "    return " << instruction.cyclesUntil << ";\n";
+        }
+    }
+
+    output << "}\n";
+}
@@ -1,15 +1,705 @@
 #include "CPU.hpp"
 
+#if defined(FAKE8080_DISPATCH_COMPUTED_GOTO) + defined(FAKE8080_DISPATCH_TAIL_CALL) + defined(FAKE8080_DISPATCH_DECODE_CACHE) + defined(FAKE8080_DISPATCH_BLOCK_CACHE) + defined(FAKE8080_DISPATCH_AOT) > 1
+#error "Solo se puede seleccionar un backend de despacho"
+#endif
+
+#if defined(FAKE8080_JIT) && !defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+#error "El JIT necesita el backend de bloques básicos"
+#endif
+
+#if defined(FAKE8080_DISPATCH_COMPUTED_GOTO) && !defined(__GNUC__)
+#error "El despacho por computed goto requiere GCC o Clang"
+#endif
+
+// Sin musttail la recursión solo se convierte en saltos si el compilador optimiza las llamadas finales
+#if defined(FAKE8080_DISPATCH_TAIL_CALL) && !defined(__OPTIMIZE__) && !__has_cpp_attribute(clang::musttail) && !__has_cpp_attribute(gnu::musttail)
+#error "El despacho por tail calls requiere musttail o compilar con optimizaciones"
+#endif
+
 void CPU::setROM(std::span<uint8_t> rom) {
-    rom_m = rom;
+    if (rom.size() == MemoryBus::Size) {
+        memory_m.attach(rom.first<MemoryBus::Size>());
+    }
+    else {
+        memory_m.load(rom);
+    }
+
+    reset();
+}
+
+void CPU::loadROM(std::span<const uint8_t> rom) {
+    memory_m.load(rom);
+    reset();
+}
+
+void CPU::reset() {
     pc_m = 0;
+    interruptsEnabled_m = false;
+    halted_m = false;
+    pendingInterrupt_m = No_Interrupt;
+    interruptCheck_m = false;
+    eiShadow_m = false;
+
+#if defined(FAKE8080_DISPATCH_DECODE_CACHE)
+    decodeCache_m.clear();
+#endif
+
+#if defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+    clearBlocks();
+#endif
+
+#if defined(FAKE8080_DISPATCH_AOT)
+    // El programa traducido corresponde a la ROM anterior
+    program_m = nullptr;
+    programBlocks_m.clear();
+    programCode_m.clear();
+#endif
+}
+
+#if defined(FAKE8080_DISPATCH_AOT)
+void CPU::setProgram(const AotProgram& program) {
+    if (program.romSize > MemoryBus::Size) {
+        throw std::invalid_argument{ "The program wasn't translated from the loaded ROM" };
+    }
+
+    // La ROM puede estar mapeada sobre bancos compartidos, se compara lo que ve la CPU y no la memoria propia del bus
+    std::vector<uint8_t> image(program.romSize);
+
+    for (uint32_t address{ 0 }; address < program.romSize; ++address) {
+        image[address] = memory_m.peek(static_cast<uint16_t>(address));
+    }
+
+    if (program.romHash != AotProgram::hash(image)) {
+        throw std::invalid_argument{ "The program wasn't translated from the loaded ROM" };
+    }
+
+    program_m = &program;
+    programBlocks_m.assign(0x10000, nullptr);
+    programCode_m.assign(0x10000, false);
+
+    for (const auto& block : program.blocks) {
+        programBlocks_m[block.start] = &block;
+
+        for (uint32_t address{ block.start }; address < block.end; ++address) {
+            programCode_m[address] = true;
+        }
+    }
+}
+#endif
+
+uint8_t CPU::cycle() {
+    return (this->*Opcodes[readNextByte()])();
+}
+
+uint64_t CPU::run(uint64_t cycleBudget) {
+    uint64_t executedCycles{ 0 };
+
+    while (executedCycles < cycleBudget) {
+        scheduler_m.runDue(cycles_m);
+
+        // La instrucción que sigue a EI se ejecuta sola, sin aceptar interrupciones aunque haya llegado alguna. Si
+        // vuelve a ser EI deja otra sombra y la siguiente vuelta del bucle la atiende
+        if (eiShadow_m) [[unlikely]] {
+            eiShadow_m = false;
+            const auto shadowCycles{ cycle() };
+            executedCycles += shadowCycles;
+            cycles_m += shadowCycles;
+            continue;
+        }
+
+        // Las solicitudes solo se miran cuando llega una nueva, sin interrupciones el bucle no paga nada
+        if (interruptCheck_m) [[unlikely]] {
+            interruptCheck_m = false;
+
+            // Sin INTE la solicitud queda pendiente hasta el próximo EI
+            if (interruptsEnabled_m && pendingInterrupt_m != No_Interrupt) {
+                const auto acceptedCycles{ acceptInterrupt() };
+                executedCycles += acceptedCycles;
+                cycles_m += acceptedCycles;
+                continue;
+            }
+        }
+
+        // Hasta el próximo evento o el final del presupuesto no hace falta mirar el planificador
+        const auto untilDeadline{ scheduler_m.nextDeadline() - cycles_m };
+        const auto sliceBudget{ std::min(cycleBudget - executedCycles, untilDeadline) };
+        const auto sliceCycles{ runSlice(sliceBudget) };
+
+        executedCycles += sliceCycles;
+        cycles_m += sliceCycles;
+
+        // HLT o un bucle de espera han cortado la porción, hasta su final solo se repetiría el mismo estado
+        if (idleCycles_m != 0) [[unlikely]] {
+            // Un evento programado durante la porción puede haber adelantado su final
+            const auto deadline{ scheduler_m.nextDeadline() };
+            const auto untilEnd{ std::min(sliceBudget - std::min(sliceBudget, sliceCycles), deadline > cycles_m ? deadline - cycles_m : 0) };
+            const auto skippedCycles{ skipIdleLoop(untilEnd) };
+            executedCycles += skippedCycles;
+            cycles_m += skippedCycles;
+        }
+    }
+
+    scheduler_m.runDue(cycles_m);
+    return executedCycles;
+}
+
+uint64_t CPU::runSlice(uint64_t cycleBudget) {
+    // Entre porciones los eventos pueden cambiar la memoria, una vuelta de la anterior ya no demuestra nada
+    sliceBudget_m = cycleBudget;
+    idleCycles_m = 0;
+    idleLoop_m.armed = false;
+
+    // Los eventos que programen los handlers durante la porción la acortan a través de sliceBudget_m
+    scheduler_m.beginSlice(cycles_m, &sliceBudget_m);
+
+#if defined(FAKE8080_DISPATCH_COMPUTED_GOTO)
+    const auto executedCycles{ runThreaded(cycleBudget) };
+#elif defined(FAKE8080_DISPATCH_TAIL_CALL)
+    const auto executedCycles{ runTailCall(cycleBudget) };
+#elif defined(FAKE8080_DISPATCH_DECODE_CACHE)
+    const auto executedCycles{ runDecoded(cycleBudget) };
+#elif defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+    const auto executedCycles{ runBlocks(cycleBudget) };
+#elif defined(FAKE8080_DISPATCH_AOT)
+    const auto executedCycles{ runProgram(cycleBudget) };
+#else
+    const auto executedCycles{ runTable(cycleBudget) };
+#endif
+
+    scheduler_m.endSlice();
+    sliceCycles_m = 0;
+    return executedCycles;
+}
+
+uint64_t CPU::runTable(uint64_t) {
+    uint64_t executedCycles{ 0 };
+
+    // Los handlers no se conocen en tiempo de compilación, el presupuesto se lee de sliceBudget_m en cada vuelta
+    while (executedCycles < sliceBudget_m) {
+        sliceCycles_m = executedCycles;
+        executedCycles += cycle();
+    }
+
+    return executedCycles;
+}
+
+#if defined(FAKE8080_DISPATCH_COMPUTED_GOTO)
+
+// Expande X(00) ... X(FF), un elemento por opcode
+#define FAKE8080_OPCODES_ROW(X, high) \
+    X(high##0) X(high##1) X(high##2) X(high##3) X(high##4) X(high##5) X(high##6) X(high##7) \
+    X(high##8) X(high##9) X(high##A) X(high##B) X(high##C) X(high##D) X(high##E) X(high##F)
+
+#define FAKE8080_OPCODES(X) \
+    FAKE8080_OPCODES_ROW(X, 0) FAKE8080_OPCODES_ROW(X, 1) FAKE8080_OPCODES_ROW(X, 2) FAKE8080_OPCODES_ROW(X, 3) \
+    FAKE8080_OPCODES_ROW(X, 4) FAKE8080_OPCODES_ROW(X, 5) FAKE8080_OPCODES_ROW(X, 6) FAKE8080_OPCODES_ROW(X, 7) \
+    FAKE8080_OPCODES_ROW(X, 8) FAKE8080_OPCODES_ROW(X, 9) FAKE8080_OPCODES_ROW(X, A) FAKE8080_OPCODES_ROW(X, B) \
+    FAKE8080_OPCODES_ROW(X, C) FAKE8080_OPCODES_ROW(X, D) FAKE8080_OPCODES_ROW(X, E) FAKE8080_OPCODES_ROW(X, F)
+
+uint64_t CPU::runThreaded(uint64_t cycleBudget) {
+#define FAKE8080_LABEL_ADDRESS(opcode) &&opcode_##opcode,
+    static void* const dispatchTable[Opcodes_Number]{ FAKE8080_OPCODES(FAKE8080_LABEL_ADDRESS) };
+#undef FAKE8080_LABEL_ADDRESS
+
+    uint64_t executedCycles{ 0 };
+
+    // Cada handler termina con su propio salto indirecto al siguiente opcode
+#define FAKE8080_DISPATCH_NEXT() \
+    if (executedCycles >= cycleBudget) { \
+        return executedCycles; \
+    } \
+    goto *dispatchTable[readNextByte()]
+
+    // Antes de acceder a un dispositivo se publican los ciclos de la porción y después se relee el presupuesto, que
+    // pueden haber reducido los eventos programados desde sus handlers
+#define FAKE8080_THREADED_HANDLER(opcode) \
+    opcode_##opcode: \
+    if constexpr (accessesDevices(0x##opcode)) { \
+        sliceCycles_m = executedCycles; \
+    } \
+    executedCycles += execute<0x##opcode>(); \
+    if constexpr (endsBlock(0x##opcode) || accessesDevices(0x##opcode)) { \
+        cycleBudget = sliceBudget_m; \
+    } \
+    FAKE8080_DISPATCH_NEXT();
+
+    FAKE8080_DISPATCH_NEXT();
+
+    FAKE8080_OPCODES(FAKE8080_THREADED_HANDLER)
+
+#undef FAKE8080_THREADED_HANDLER
+#undef FAKE8080_DISPATCH_NEXT
+}
+
+#undef FAKE8080_OPCODES
+#undef FAKE8080_OPCODES_ROW
+
+#endif // FAKE8080_DISPATCH_COMPUTED_GOTO
+
+#if defined(FAKE8080_DISPATCH_TAIL_CALL)
+
+constexpr std::array<CPU::TailCallHandler, CPU::Opcodes_Number> CPU::TailCallHandlers{
+    []<size_t... Opcode>(std::index_sequence<Opcode...>) {
+        return std::array<TailCallHandler, Opcodes_Number>{ &CPU::tailCallHandler<Opcode>... };
+    }(std::make_index_sequence<Opcodes_Number>{})
+};
+
+uint64_t CPU::runTailCall(uint64_t cycleBudget) {
+    return dispatchTailCall(*this, pc_m, registers_m.getRegister(Registers::Register::A), registers_m.getRegister(Registers::Register::F), 0, cycleBudget);
+}
+
+uint64_t CPU::dispatchTailCall(CPU& cpu, uint16_t pc, uint8_t a, uint8_t f, uint64_t executedCycles, uint64_t cycleBudget) {
+    if (executedCycles >= cycleBudget) [[unlikely]] {
+        cpu.pc_m = pc;
+        cpu.registers_m.setRegister(Registers::Register::A, a);
+        cpu.registers_m.replaceFlags(f);
+
+        return executedCycles;
+    }
+
+    const auto opcode{ cpu.readMemory(pc) };
+    ++pc;
+
+    FAKE8080_MUSTTAIL return TailCallHandlers[opcode](cpu, pc, a, f, executedCycles, cycleBudget);
+}
+
+template <uint8_t Opcode>
+uint64_t CPU::tailCallHandler(CPU& cpu, uint16_t pc, uint8_t a, uint8_t f, uint64_t executedCycles, uint64_t cycleBudget) {
+    constexpr uint8_t ddd{ (Opcode >> 3) & 0b111 };
+    constexpr uint8_t sss{ Opcode & 0b111 };
+
+    // Implementaciones nativas de los opcodes más frecuentes, sin tocar registers_m para pc, A y F
+    if constexpr (Opcode == 0x00) {
+        executedCycles += NOP_Cycles;
+    }
+    else if constexpr (Opcode == 0xC3) {
+        const auto end{ static_cast<uint16_t>(pc + 2) };
+        pc = static_cast<uint16_t>(cpu.readMemory(static_cast<uint16_t>(pc + 1))) << Byte_Shift | cpu.readMemory(pc);
+        executedCycles += JMP_a16_Cycles;
+
+        // Un salto corto hacia atrás puede cerrar un bucle de espera, que se comprueba con el estado completo
+        if (static_cast<uint16_t>(end - pc) <= Max_Idle_Loop_Bytes) [[unlikely]] {
+            cpu.pc_m = pc;
+            cpu.registers_m.setRegister(Registers::Register::A, a);
+            cpu.registers_m.replaceFlags(f);
+            cpu.jumpTaken(end);
+            cycleBudget = cpu.sliceBudget_m;
+        }
+    }
+    else if constexpr (Opcode == 0x3E) {
+        a = cpu.readMemory(pc);
+        ++pc;
+        executedCycles += MVI_R_d8_Cycles;
+    }
+    else if constexpr ((Opcode >> 6) == 0b01 && ddd == 7 && sss != Encoded_M) {
+        // MOV A, r
+        if constexpr (sss != 7) {
+            a = cpu.registers_m.getRegister(Encoded_Registers[sss]);
+        }
+        executedCycles += MOV_R_R_Cycles;
+    }
+    else if constexpr ((Opcode >> 6) == 0b01 && sss == 7 && ddd != Encoded_M) {
+        // MOV r, A
+        cpu.registers_m.setRegister(Encoded_Registers[ddd], a);
+        executedCycles += MOV_R_R_Cycles;
+    }
+    else {
+        constexpr uint8_t usage{ hotStateUsage(Opcode) };
+
+        if constexpr ((usage & Hot_PC) != 0) {
+            cpu.pc_m = pc;
+        }
+        if constexpr ((usage & Hot_A) != 0) {
+            cpu.registers_m.setRegister(Registers::Register::A, a);
+        }
+        if constexpr ((usage & Hot_F) != 0) {
+            cpu.registers_m.replaceFlags(f);
+        }
+        if constexpr (accessesDevices(Opcode)) {
+            cpu.sliceCycles_m = executedCycles;
+        }
+
+        executedCycles += cpu.execute<Opcode>();
+
+        if constexpr ((usage & Hot_PC) != 0) {
+            pc = cpu.pc_m;
+        }
+        if constexpr ((usage & Hot_A) != 0) {
+            a = cpu.registers_m.getRegister(Registers::Register::A);
+        }
+        if constexpr ((usage & Hot_F) != 0) {
+            f = cpu.registers_m.getRegister(Registers::Register::F);
+        }
+        if constexpr (endsBlock(Opcode) || accessesDevices(Opcode)) {
+            cycleBudget = cpu.sliceBudget_m;
+        }
+    }
+
+    FAKE8080_MUSTTAIL return dispatchTailCall(cpu, pc, a, f, executedCycles, cycleBudget);
+}
+
+#endif // FAKE8080_DISPATCH_TAIL_CALL
+
+#if defined(FAKE8080_DISPATCH_DECODE_CACHE)
+
+uint64_t CPU::runDecoded(uint64_t) {
+    uint64_t executedCycles{ 0 };
+
+    // Los handlers no se conocen en tiempo de compilación, el presupuesto se lee de sliceBudget_m en cada vuelta
+    while (executedCycles < sliceBudget_m) {
+        const auto* instruction{ decodeCache_m.find(pc_m) };
+
+        if (instruction == nullptr) [[unlikely]] {
+            instruction = &decode(pc_m);
+        }
+
+        // El operando ya está decodificado, el handler empieza con el pc tras la instrucción completa
+        pc_m = static_cast<uint16_t>(pc_m + instruction->length);
+        sliceCycles_m = executedCycles;
+        executedCycles += instruction->handler(*this, instruction->operand);
+    }
+
+    return executedCycles;
+}
+
+const DecodeCache::Instruction& CPU::decode(uint16_t pc) {
+    const auto opcode{ readMemory(pc) };
+
+    DecodeCache::Instruction instruction{ };
+    instruction.handler = Invokers[opcode];
+    instruction.length = Opcodes_Length[opcode];
+    instruction.operand = readOperand(pc);
+
+    return decodeCache_m.insert(pc, instruction);
+}
+
+#endif // FAKE8080_DISPATCH_DECODE_CACHE
+
+uint16_t CPU::readOperand(uint16_t pc) const {
+    switch (Opcodes_Length[readMemory(pc)]) {
+    case 2:
+        return readMemory(static_cast<uint16_t>(pc + 1));
+    case 3:
+        return static_cast<uint16_t>(readMemory(static_cast<uint16_t>(pc + 2))) << Byte_Shift | readMemory(static_cast<uint16_t>(pc + 1));
+    default:
+        return 0;
+    }
+}
+
+#if defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+
+uint64_t CPU::runBlocks(uint64_t) {
+    uint64_t executedCycles{ 0 };
+    BlockCache::Block* previous{ nullptr };
+
+    // Todos los bloques terminan en la instrucción que puede cortar la porción
+    while (executedCycles < sliceBudget_m) {
+        auto& block{ nextBlock(previous) };
+
+        // Si el presupuesto se agota antes de empezar la última instrucción se termina paso a paso,
+        // así el resultado es idéntico al de los demás backends
+        if (executedCycles + block.bodyCycles >= sliceBudget_m) {
+            while (executedCycles < sliceBudget_m) {
+                sliceCycles_m = executedCycles;
+                executedCycles += cycle();
+            }
+
+            break;
+        }
+
+        const auto lastOperation{ block.operations.size() - 1 };
+        size_t index{ 0 };
+
+        // Los handlers de las páginas de E/S pueden consultar getCycles() o programar eventos en mitad del bloque,
+        // que se ejecuta paso a paso para que vean la frontera de instrucción exacta
+        if (block.accessesMemory && memory_m.hasIO()) [[unlikely]] {
+            for (size_t step{ 0 }; step < block.operations.size() && executedCycles < sliceBudget_m; ++step) {
+                sliceCycles_m = executedCycles;
+                executedCycles += cycle();
+            }
+
+            codeModified_m = false;
+            previous = nullptr;
+            continue;
+        }
+
+#if defined(FAKE8080_JIT)
+        // Si el buffer ha dejado de ser ejecutable los bloques ya compilados vuelven al intérprete
+        if (block.native != nullptr && jit_m.isExecutable()) [[likely]] {
+            const auto nativeCycles{ runNative(block) };
+
+            if (codeModified_m || block.nativeOperations == block.operations.size()) {
+                executedCycles += nativeCycles;
+                previous = codeModified_m ? nullptr : &block;
+                codeModified_m = false;
+                continue;
+            }
+
+            // El resto del bloque lo ejecuta el intérprete, sus ciclos acumulados ya incluyen la parte nativa
+            index = block.nativeOperations;
+        }
+        else if (++block.executions == JitCompiler::Hotness_Threshold) {
+            jit_m.compile(block);
+        }
+#endif
+
+        for (; index < lastOperation; ++index) {
+            const auto& operation{ block.operations[index] };
+            pc_m = static_cast<uint16_t>(pc_m + operation.length);
+            operation.handler(*this, operation.operand);
+
+            // Una escritura sobre código ya traducido obliga a salir del bloque
+            if (codeModified_m) [[unlikely]] {
+                break;
+            }
+        }
+
+        if (index < lastOperation) [[unlikely]] {
+            executedCycles += block.operations[index].cyclesUntil;
+            codeModified_m = false;
+            previous = nullptr;
+            continue;
+        }
+
+        const auto& terminator{ block.operations[lastOperation] };
+        pc_m = static_cast<uint16_t>(pc_m + terminator.length);
+        sliceCycles_m = executedCycles + block.bodyCycles;
+        executedCycles += block.bodyCycles + terminator.handler(*this, terminator.operand);
+
+        codeModified_m = false;
+        previous = &block;
+    }
+
+    return executedCycles;
+}
+
+BlockCache::Block& CPU::nextBlock(BlockCache::Block* previous) {
+    if (blockCache_m.needsCollection()) [[unlikely]] {
+        clearBlocks();
+        previous = nullptr;
+    }
+
+    if (previous != nullptr) {
+        for (auto* link : previous->links) {
+            if (link != nullptr && link->valid && link->start == pc_m) {
+                return *link;
+            }
+        }
+    }
+
+    auto* block{ blockCache_m.find(pc_m) };
+
+    if (block == nullptr) {
+        block = &translateBlock(pc_m);
+    }
+
+    if (previous != nullptr) {
+        for (uint8_t i{ 0 }; i < previous->successorsNumber; ++i) {
+            if (previous->successors[i] == pc_m) {
+                previous->links[i] = block;
+            }
+        }
+    }
+
+    return *block;
+}
+
+BlockCache::Block& CPU::translateBlock(uint16_t pc) {
+    auto block{ std::make_unique<BlockCache::Block>() };
+    block->start = pc;
+
+    uint32_t address{ pc };
+    uint32_t cycles{ 0 };
+    uint8_t opcode{ 0 };
+
+    // El bloque no cruza el final de la memoria para que [start, end) sea un rango continuo
+    while (address < 0x10000) {
+        opcode = readMemory(static_cast<uint16_t>(address));
+
+        if (address + Opcodes_Length[opcode] > 0x10000) {
+            break;
+        }
+
+        block->bodyCycles = cycles;
+        cycles += Opcodes_Cycles[opcode];
+        block->operations.push_back(BlockCache::Operation{ Invokers[opcode], cycles, readOperand(static_cast<uint16_t>(address)), opcode, Opcodes_Length[opcode] });
+        address += Opcodes_Length[opcode];
+
+        if (Block_Terminators[opcode] || block->operations.size() == BlockCache::Max_Block_Instructions) {
+            break;
+        }
+    }
+
+    // Una instrucción cortada por el final de la memoria se ejecuta igualmente como última del bloque. Sus operandos
+    // están en 0x0000, fuera del rango que invalida el bloque, así que se leen de memoria cada vez
+    if (block->operations.empty()) {
+        block->operations.push_back(BlockCache::Operation{ &CPU::fetchAndExecute, Opcodes_Cycles[opcode], 0, opcode, 0 });
+        address = 0x10000;
+    }
+
+    block->end = address;
+    block->accessesMemory = std::any_of(block->operations.begin(), block->operations.end() - 1, [](const auto& operation) {
+        return accessesDevices(operation.opcode);
+    });
+
+    const auto target{ static_cast<uint16_t>(readMemory(static_cast<uint16_t>(address - 1)) << Byte_Shift | readMemory(static_cast<uint16_t>(address - 2))) };
+    const bool unconditional{ opcode == 0xC3 || opcode == 0xCB || opcode == 0xC9 || opcode == 0xD9 || opcode == 0xE9 || (opcode & 0b11001111) == 0b11001101 };
+
+    if (Block_Terminators[opcode] && Opcodes_Length[opcode] == 3) {
+        block->successors[block->successorsNumber++] = target;                  // JMP, Jcc, CALL y Ccc
+    }
+    else if ((opcode & 0b11000111) == 0b11000111) {
+        block->successors[block->successorsNumber++] = opcode & 0b00111000;     // RST
+    }
+
+    if (!unconditional && (opcode & 0b11000111) != 0b11000111 && address < 0x10000) {
+        block->successors[block->successorsNumber++] = static_cast<uint16_t>(address);
+    }
+
+    return blockCache_m.insert(std::move(block));
+}
+
+uint8_t CPU::fetchAndExecute(CPU& cpu, uint16_t) {
+    return cpu.cycle();
+}
+
+void CPU::clearBlocks() noexcept {
+    blockCache_m.clear();
+
+#if defined(FAKE8080_JIT)
+    jit_m.reset();
+#endif
+}
+
+#endif // FAKE8080_DISPATCH_BLOCK_CACHE
+
+void CPU::switchBank(uint16_t first, uint16_t last, std::span<uint8_t> bank, bool writable) {
+    if (memory_m.mapBank(first, last, bank, writable)) {
+        invalidateCode(first, last);
+    }
+}
+
+void CPU::invalidateCode(uint16_t first, uint16_t last) {
+    for (uint16_t page{ getHighByte(first) }; page <= getHighByte(last); ++page) {
+#if defined(FAKE8080_DISPATCH_DECODE_CACHE)
+        decodeCache_m.invalidatePage(static_cast<uint8_t>(page));
+#endif
+
+#if defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+        codeModified_m |= blockCache_m.invalidatePage(static_cast<uint8_t>(page));
+#endif
+    }
+
+#if defined(FAKE8080_DISPATCH_AOT)
+    if (program_m != nullptr) {
+        discardProgramBlocks(first, last);
+        codeModified_m = true;
+    }
+#endif
+}
+
+#if defined(FAKE8080_JIT)
+
+uint32_t CPU::runNative(const BlockCache::Block& block) {
+    // Orden de JitState::registers
+    static constexpr std::array Jit_Registers{
+        Registers::Register::B, Registers::Register::C, Registers::Register::D, Registers::Register::E,
+        Registers::Register::H, Registers::Register::L, Registers::Register::A, Registers::Register::F
+    };
+
+    JitState state{ };
+
+    for (uint8_t i{ 0 }; i < Jit_Registers.size(); ++i) {
+        state.registers[i] = registers_m.getRegister(Jit_Registers[i]);
+    }
+
+    state.sp = registers_m.getCombinedRegister(Registers::CombinedRegister::SP);
+    state.pc = pc_m;
+    state.cpu = this;
+    state.read = &CPU::jitRead;
+    state.write = &CPU::jitWrite;
+
+    const auto cycles{ block.native(&state) };
+
+    for (uint8_t i{ 0 }; i < Jit_Registers.size(); ++i) {
+        registers_m.setRegister(Jit_Registers[i], state.registers[i]);
+    }
+
+    registers_m.setCombinedRegister(Registers::CombinedRegister::SP, state.sp);
+    pc_m = state.pc;
+
+    return cycles;
+}
+
+uint8_t CPU::jitRead(CPU& cpu, uint16_t address) {
+    return cpu.readMemory(address);
+}
+
+uint8_t CPU::jitWrite(CPU& cpu, uint16_t address, uint8_t value) {
+    cpu.writeMemory(address, value);
+    return cpu.codeModified_m;
+}
+
+#endif // FAKE8080_JIT
+
+#if defined(FAKE8080_DISPATCH_AOT)
+
+uint64_t CPU::runProgram(uint64_t) {
+    uint64_t executedCycles{ 0 };
+
+    while (executedCycles < sliceBudget_m) {
+        const auto* block{ programBlocks_m.empty() ? nullptr : programBlocks_m[pc_m] };
+
+        // Los saltos indirectos a código no traducido y el final del presupuesto se interpretan paso a paso,
+        // así el resultado es idéntico al de los demás backends
+        // Con páginas de E/S los bloques que acceden a memoria también van paso a paso, para que sus handlers vean la
+        // frontera de instrucción exacta
+        if (block == nullptr || executedCycles + block->bodyCycles >= sliceBudget_m || (block->accessesMemory && memory_m.hasIO())) {
+            sliceCycles_m = executedCycles;
+            executedCycles += cycle();
+            continue;
+        }
+
+        codeModified_m = false;
+
+        // Solo el terminador puede acceder a los puertos
+        sliceCycles_m = executedCycles + block->bodyCycles;
+        executedCycles += block->function(*this);
+    }
+
+    return executedCycles;
 }
 
-void CPU::cycle() {
+void CPU::discardProgramBlocks(uint16_t address) {
+    discardProgramBlocks(address, address);
 }
 
+void CPU::discardProgramBlocks(uint16_t first, uint16_t last) {
+    const auto blocks{ program_m->blocks };
+
+    // Los bloques están ordenados por inicio y ninguno ocupa más de Max_Block_Instructions instrucciones de 3 bytes
+    auto it{ std::upper_bound(blocks.begin(), blocks.end(), last, [](uint16_t value, const AotProgram::Block& block) {
+        return value < block.start;
+    }) };
+
+    while (it != blocks.begin()) {
+        --it;
+
+        if (it->start < first && first - it->start >= BlockCache::Max_Block_Instructions * 3) {
+            break;
+        }
+
+        if (first < it->end) {
+            programBlocks_m[it->start] = nullptr;
+        }
+    }
+}
+
+#endif // FAKE8080_DISPATCH_AOT
+
 uint8_t CPU::readNextByte() {
-    const auto byte{ rom_m[pc_m] };
+    const auto byte{ readMemory(pc_m) };
     ++pc_m;
     return byte;
 }
@@ -29,7 +719,7 @@ void CPU::increaseSP() {
 }
 
 uint8_t CPU::getM() {
-    return rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::HL)];
+    return readMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::HL));
 }
 
 void CPU::loadMtoW() {
@@ -37,10 +727,28 @@ void CPU::loadMtoW() {
 }
 
 void CPU::writeWtoM() {
-    rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::HL)] = registers_m.getRegister(Registers::Register::W);
+    writeMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::HL), registers_m.getRegister(Registers::Register::W));
 }
 
-void CPU::InvalidOpcode()
+void CPU::pushWord(uint16_t value) {
+    decreaseSP();
+    writeMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::SP), getHighByte(value));
+
+    decreaseSP();
+    writeMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::SP), getLowBytes(value));
+}
+
+uint16_t CPU::popWord() {
+    const uint8_t lowByte{ readMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::SP)) };
+    increaseSP();
+
+    const uint8_t highByte{ readMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::SP)) };
+    increaseSP();
+
+    return static_cast<uint16_t>(highByte) << Byte_Shift | lowByte;
+}
+
+uint8_t CPU::InvalidOpcode()
 {
     throw std::runtime_error{ "The opcode isn't implemented" };
 }
@@ -50,12 +758,7 @@ void CPU::manageZeroFlag(uint8_t value) noexcept {
 }
 
 void CPU::manageParityFlag(uint8_t value) noexcept {
-    uint8_t accumulator{ 0 };
-    for (uint8_t i{ 0 }; i < Byte_Shift; ++i) {
-        accumulator += (value >> i) & 1;
-    }
-    
-    registers_m.setFlag(Registers::Flags::P, (accumulator % 2) == 0);
+    registers_m.setFlag(Registers::Flags::P, (Flags_SZP[value] & Flag_P) != 0);
 }
 
 void CPU::manageSignedFlag(uint8_t value) noexcept {
@@ -97,23 +800,24 @@ void CPU::manageAuxilaryCarryFlag(uint8_t first, uint8_t second, AritmeticOperat
 }
 
 uint8_t CPU::aritmeticOperation_8bits(uint8_t first, uint8_t second, AritmeticOperation op, bool useCarry, bool modifyCarry) noexcept {
-    const uint8_t result = first + ((second + (useCarry && registers_m.getFlag(Registers::Flags::CY))) * (op == AritmeticOperation::ADD ? 1 : -1));
-
-    manageAuxilaryCarryFlag(first, second, op, useCarry);
-
-    if (modifyCarry) {
-        manageCarryFlag(first, second, op, useCarry);
+    const bool carry{ useCarry && registers_m.getFlag(Registers::Flags::CY) };
+    const uint32_t wide{ op == AritmeticOperation::ADD ? first + second + carry : static_cast<uint32_t>(first - second - carry) };
+    const auto result{ static_cast<uint8_t>(wide) };
+
+    // Las flags se calculan cuando alguien lee F, normalmente la siguiente operación las sobrescribe antes
+    if constexpr (Lazy_Flags_Enabled) {
+        registers_m.deferArithmeticFlags(first, second, result, carry, op == AritmeticOperation::SUB, modifyCarry);
+        return result;
     }
 
-    manageZeroFlag(result);
-    manageParityFlag(result);
-    manageSignedFlag(result);
+    const uint8_t mask = modifyCarry ? Flags_SZACPCY : Flags_SZACPCY & ~Flag_CY;
+    registers_m.setFlags(mask, arithmeticFlags(first, second, wide));
 
     return result;
 }
 
 uint8_t CPU::STC() {
-    registers_m.setFlag(Registers::Flags::CY, 1);
+    registers_m.setFlags(Flag_CY, Flag_CY);
 
     return STC_DAA_CMA_CMC_Cycles;
 }
@@ -125,37 +829,18 @@ uint8_t CPU::CMA() {
 }
 
 uint8_t CPU::CMC() {
-    registers_m.setFlag(Registers::Flags::CY, !registers_m.getFlag(Registers::Flags::CY));
+    registers_m.setFlags(Flag_CY, ~registers_m.getRegister(Registers::Register::F));
 
     return STC_DAA_CMA_CMC_Cycles;
 }
 
 uint8_t CPU::DAA() {
-    uint8_t accumulator = registers_m.getRegister(Registers::Register::A);
-    uint8_t lowerNibble = accumulator & 0x0F;
-    uint8_t upperNibble = accumulator >> 4;
-    bool carry = registers_m.getFlag(Registers::Flags::CY);
-    bool auxCarry = registers_m.getFlag(Registers::Flags::AC);
-    
-    // Ajustar el nibble inferior
-    if (auxCarry || lowerNibble > 9) {
-        accumulator += 0x06;
-    }
-    
-    // Ajustar el nibble superior (usar el nibble superior actualizado)
-    if (carry || (accumulator >> 4) > 9) {
-        accumulator += 0x60;
-        carry = true;
-    }
-    
-    registers_m.setRegister(Registers::Register::A, accumulator);
-    registers_m.setFlag(Registers::Flags::CY, carry);
-    
-    // Actualizar flags de condición
-    manageZeroFlag(accumulator);
-    manageParityFlag(accumulator);
-    manageSignedFlag(accumulator);
-    
+    const auto flags{ registers_m.getRegister(Registers::Register::F) };
+    const auto adjusted{ Daa_Results[daaIndex(registers_m.getRegister(Registers::Register::A), flags & Flag_AC, flags & Flag_CY)] };
+
+    registers_m.setRegister(Registers::Register::A, getHighByte(adjusted));
+    registers_m.setFlags(Flags_SZACPCY, getLowBytes(adjusted));
+
     return STC_DAA_CMA_CMC_Cycles;
 }
 
@@ -200,23 +885,33 @@ uint8_t CPU::DCR_M() {
 }
 
 uint8_t CPU::MVI_M_d8() {
-    rom_m[registers_m.getCombinedRegister(Registers::CombinedRegister::HL)] = readNextByte();
+    return MVI_M(readNextByte());
+}
+
+uint8_t CPU::MVI_M(uint8_t value) {
+    writeMemory(registers_m.getCombinedRegister(Registers::CombinedRegister::HL), value);
 
     return MVI_M_d8_Cycles;
 }
 
 uint8_t CPU::SHLD_a16() {
-    const auto address{ readNextTwoBytes() };
-    rom_m[address] = registers_m.getRegister(Registers::Register::L);
-    rom_m[address + 1] = registers_m.getRegister(Registers::Register::H);
+    return SHLD(readNextTwoBytes());
+}
+
+uint8_t CPU::SHLD(uint16_t address) {
+    writeMemory(address, registers_m.getRegister(Registers::Register::L));
+    writeMemory(static_cast<uint16_t>(address + 1), registers_m.getRegister(Registers::Register::H));
 
     return SHLD_Cycles;
 }
 
 uint8_t CPU::LHLD_a16() {
-    const auto address{ readNextTwoBytes() };
-    registers_m.setRegister(Registers::Register::L, rom_m[address]);
-    registers_m.setRegister(Registers::Register::H, rom_m[address + 1]);
+    return LHLD(readNextTwoBytes());
+}
+
+uint8_t CPU::LHLD(uint16_t address) {
+    registers_m.setRegister(Registers::Register::L, readMemory(address));
+    registers_m.setRegister(Registers::Register::H, readMemory(static_cast<uint16_t>(address + 1)));
 
     return LHLD_Cycles;
 }
@@ -254,14 +949,22 @@ uint8_t CPU::XRI_d8() {
 }
 
 uint8_t CPU::STA_a16() {
-    registers_m.setCombinedRegister(Registers::CombinedRegister::WZ, readNextTwoBytes());
+    return STA(readNextTwoBytes());
+}
+
+uint8_t CPU::STA(uint16_t address) {
+    registers_m.setCombinedRegister(Registers::CombinedRegister::WZ, address);
     STAX_RR<Registers::CombinedRegister::WZ>();
 
     return STA_a16_Cycles;
 }
 
 uint8_t CPU::LDA_a16() {
-    registers_m.setCombinedRegister(Registers::CombinedRegister::WZ, readNextTwoBytes());
+    return LDA(readNextTwoBytes());
+}
+
+uint8_t CPU::LDA(uint16_t address) {
+    registers_m.setCombinedRegister(Registers::CombinedRegister::WZ, address);
     LDAX_RR<Registers::CombinedRegister::WZ>();
 
     return LDA_a16_Cycles;
@@ -272,13 +975,13 @@ uint8_t CPU::XTHL() {
 
     uint8_t exchangeAux{ registers_m.getRegister(Registers::Register::L) };
 
-    registers_m.setRegister(Registers::Register::L, rom_m[SP_value]);
-    rom_m[SP_value] = exchangeAux;
+    registers_m.setRegister(Registers::Register::L, readMemory(SP_value));
+    writeMemory(SP_value, exchangeAux);
 
     exchangeAux = registers_m.getRegister(Registers::Register::H);
 
-    registers_m.setRegister(Registers::Register::H, rom_m[SP_value + 1]);
-    rom_m[SP_value + 1] = exchangeAux;
+    registers_m.setRegister(Registers::Register::H, readMemory(static_cast<uint16_t>(SP_value + 1)));
+    writeMemory(static_cast<uint16_t>(SP_value + 1), exchangeAux);
 
     return XTHL_Cycles;
 }
@@ -291,3 +994,198 @@ uint8_t CPU::XCHG() {
 
     return XCHG_Cycles;
 }
+
+
+uint8_t CPU::SPHL() {
+    registers_m.setCombinedRegister(Registers::CombinedRegister::SP, registers_m.getCombinedRegister(Registers::CombinedRegister::HL));
+
+    return SPHL_Cycles;
+}
+
+uint8_t CPU::OUT_d8() {
+    return OUT(readNextByte());
+}
+
+uint8_t CPU::OUT(uint8_t port) {
+    ports_m.write(port, registers_m.getRegister(Registers::Register::A));
+
+    return IN_OUT_d8_Cycles;
+}
+
+uint8_t CPU::IN_d8() {
+    return IN(readNextByte());
+}
+
+uint8_t CPU::IN(uint8_t port) {
+    registers_m.setRegister(Registers::Register::A, ports_m.read(port));
+
+    return IN_OUT_d8_Cycles;
+}
+
+uint8_t CPU::NOP() {
+    return NOP_Cycles;
+}
+
+uint8_t CPU::JMP_a16() {
+    return JMP(readNextTwoBytes());
+}
+
+uint8_t CPU::JMP(uint16_t address) {
+    const auto end{ pc_m };
+    pc_m = address;
+    jumpTaken(end);
+
+    return JMP_a16_Cycles;
+}
+
+uint8_t CPU::CALL_a16() {
+    return CALL(readNextTwoBytes());
+}
+
+uint8_t CPU::CALL(uint16_t address) {
+    pushWord(pc_m);
+    pc_m = address;
+
+    return CALL_a16_Cycles;
+}
+
+uint8_t CPU::RET() {
+    pc_m = popWord();
+
+    return RET_Cycles;
+}
+
+uint8_t CPU::PCHL() {
+    pc_m = registers_m.getCombinedRegister(Registers::CombinedRegister::HL);
+
+    return PCHL_Cycles;
+}
+
+uint8_t CPU::DI() {
+    interruptsEnabled_m = false;
+
+    return EI_DI_Cycles;
+}
+
+uint8_t CPU::EI() {
+    interruptsEnabled_m = true;
+    eiShadow_m = true;
+    sliceBudget_m = 0;
+
+    // Una solicitud que llegó con INTE deshabilitado se vuelve a mirar tras la sombra
+    if (pendingInterrupt_m != No_Interrupt) {
+        interruptCheck_m = true;
+    }
+
+    return EI_DI_Cycles;
+}
+
+uint8_t CPU::HLT() {
+    halted_m = true;
+    --pc_m;
+    enterIdle(HLT_Cycles);
+
+    return HLT_Cycles;
+}
+
+void CPU::checkIdleLoop(uint16_t end) {
+    auto& loop{ idleLoop_m };
+    const bool sameLoop{ loop.armed && loop.start == pc_m && loop.end == end };
+
+    if (sameLoop && loop.cycles == 0) {
+        return;
+    }
+
+    const auto a{ registers_m.getRegister(Registers::Register::A) };
+    const auto f{ registers_m.getRegister(Registers::Register::F) };
+
+    if (sameLoop && loop.a == a && loop.f == f) {
+        enterIdle(loop.cycles);
+        return;
+    }
+
+    // El código y las páginas que lee se analizan al armar el bucle, la vuelta que lo confirma es de la misma porción
+    if (!sameLoop) {
+        loop.start = pc_m;
+        loop.end = end;
+        loop.cycles = idleLoopCycles(pc_m, end);
+        loop.armed = true;
+    }
+
+    loop.a = a;
+    loop.f = f;
+}
+
+uint8_t CPU::idleLoopCycles(uint16_t start, uint16_t end) const {
+    const auto jump{ static_cast<uint16_t>(end - Opcodes_Length[0xC3]) };
+
+    if (memory_m.isIO(start) || memory_m.isIO(static_cast<uint16_t>(end - 1))) {
+        return 0;
+    }
+
+    // El cuerpo no toca BC, DE ni HL, así que las direcciones que lee son las mismas en todas las vueltas
+    const auto bc{ registers_m.getCombinedRegister(Registers::CombinedRegister::BC) };
+    const auto de{ registers_m.getCombinedRegister(Registers::CombinedRegister::DE) };
+    const auto hl{ registers_m.getCombinedRegister(Registers::CombinedRegister::HL) };
+
+    uint16_t address{ start };
+    uint8_t cycles{ 0 };
+
+    while (address != jump) {
+        const auto opcode{ readMemory(address) };
+        const auto length{ Opcodes_Length[opcode] };
+
+        if (!isIdleSafe(opcode) || length > static_cast<uint16_t>(jump - address)) {
+            return 0;
+        }
+
+        const bool readsIO{
+            (opcode == 0x0A && memory_m.isIO(bc)) ||
+            (opcode == 0x1A && memory_m.isIO(de)) ||
+            (opcode == 0x3A && memory_m.isIO(readOperand(address))) ||
+            ((opcode & 0b111) == Encoded_M && (opcode >> 6) != 0b00 && (opcode >> 6) != 0b11 && memory_m.isIO(hl))
+        };
+
+        if (readsIO) {
+            return 0;
+        }
+
+        cycles += Opcodes_Cycles[opcode];
+        address += length;
+    }
+
+    // Jcc cuesta lo mismo se cumpla o no la condición
+    const auto closing{ readMemory(jump) };
+    const bool isJump{ closing == 0xC3 || closing == 0xCB || (closing & 0b11000111) == 0b11000010 };
+
+    return isJump ? static_cast<uint8_t>(cycles + Jcc_a16_Cycles) : 0;
+}
+
+uint64_t CPU::skipIdleLoop(uint64_t remainingCycles) {
+    const uint64_t loopCycles{ idleCycles_m };
+    idleCycles_m = 0;
+
+    // Solo se adelantan las vueltas que terminan antes del final de la porción, la que lo alcanza se ejecuta
+    // normalmente para que el evento vea la misma frontera de instrucción que sin adelantar
+    if (pc_m != idlePC_m || remainingCycles <= loopCycles) {
+        return 0;
+    }
+
+    return (remainingCycles - 1) / loopCycles * loopCycles;
+}
+
+uint8_t CPU::acceptInterrupt() {
+    interruptsEnabled_m = false;
+
+    // El pc sigue apuntando al HLT, el retorno debe ser la instrucción siguiente
+    if (halted_m) {
+        halted_m = false;
+        ++pc_m;
+    }
+
+    pushWord(pc_m);
+    pc_m = static_cast<uint16_t>(pendingInterrupt_m << 3);
+    pendingInterrupt_m = No_Interrupt;
+
+    return RST_Cycles;
+}
\ No newline at end of file
@@ -1,22 +1,107 @@
 #include "Fake8080.hpp"
 
-Fake8080::Fake8080(std::string_view romPath) {
-    loadRom(romPath);
-    cpu_m.setROM(loadedROM_m);
+#include <algorithm>
+#include <stdexcept>
+
+Fake8080::Fake8080(std::string_view romPath) : Fake8080{ std::span<const std::string_view>{ &romPath, 1 } } {
+}
+
+Fake8080::Fake8080(std::span<const std::string_view> romPaths) {
+    loadROMs(romPaths);
+
+    // Sin rangos explícitos todo lo que hay por encima de las páginas completas de las ROMs es RAM
+    const size_t sharedSize{ romSize_m & ~(MemoryBus::Page_Size - 1) };
+
+    if (sharedSize < MemoryBus::Size) {
+        const RamRange range{ static_cast<uint16_t>(sharedSize), 0xFFFF };
+        mapMemory(std::span<const RamRange>{ &range, 1 });
+    } else {
+        mapMemory({});
+    }
+}
+
+Fake8080::Fake8080(std::span<const std::string_view> romPaths, std::span<const RamRange> ramRanges) {
+    loadROMs(romPaths);
+    mapMemory(ramRanges);
 }
 
-void Fake8080::loadRom(std::string_view path) {
-    std::ifstream romFile{ path.data(), std::ios::binary | std::ios::ate };
+void Fake8080::loadROMs(std::span<const std::string_view> romPaths) {
+    roms_m.reserve(romPaths.size());
+
+    for (const auto path : romPaths) {
+        if (romSize_m % MemoryBus::Page_Size != 0) {
+            throw std::invalid_argument{ "Only the last ROM can end in the middle of a page" };
+        }
+
+        roms_m.push_back(RomImage::open(path));
+        romSize_m += roms_m.back()->data().size();
+    }
+
+    if (romSize_m > MemoryBus::Size) {
+        throw std::invalid_argument{ "The ROM doesn't fit in the 16-bit address space" };
+    }
+}
+
+void Fake8080::mapMemory(std::span<const RamRange> ramRanges) {
+    const size_t sharedSize{ romSize_m & ~(MemoryBus::Page_Size - 1) };
+    size_t nextFree{ sharedSize };
+    size_t ramSize{ 0 };
+
+    for (const auto& range : ramRanges) {
+        if (range.first < nextFree || range.last < range.first) {
+            throw std::invalid_argument{ "The RAM ranges must be in order and above the ROM pages" };
+        }
 
-    if (!romFile) {
-        throw std::runtime_error{ "Cant open ROM file" };
+        nextFree = static_cast<size_t>(range.last) + 1;
+        ramSize += nextFree - range.first;
     }
 
-    const auto fileSize{ romFile.tellg() };
-    loadedROM_m.reserve(fileSize);
+    ram_m.assign(ramSize, 0);
 
-    romFile.seekg(std::ios::beg);
-    for (size_t i{ 0 }; i < fileSize; ++i) {
-        loadedROM_m.emplace_back(romFile.get());
+    if (!ramRanges.empty()) {
+        ramStart_m = ramRanges.front().first;
     }
+
+    auto& bus{ cpu_m.memoryBus() };
+    bus.unmap(0, 0xFFFF);
+
+    // Las páginas completas de las ROMs se leen directamente de las imágenes compartidas
+    size_t address{ 0 };
+
+    for (const auto& image : roms_m) {
+        const auto rom{ image->data() };
+        const size_t pagesSize{ rom.size() & ~(MemoryBus::Page_Size - 1) };
+
+        if (pagesSize > 0) {
+            bus.mapROMBank(static_cast<uint16_t>(address), static_cast<uint16_t>(address + pagesSize - 1), rom.first(pagesSize));
+        }
+
+        address += rom.size();
+    }
+
+    size_t offset{ 0 };
+
+    for (const auto& range : ramRanges) {
+        const size_t size{ static_cast<size_t>(range.last) + 1 - range.first };
+        bus.mapBank(range.first, range.last, std::span<uint8_t>{ ram_m }.subspan(offset, size));
+        offset += size;
+    }
+
+    // El resto de la última página de las ROMs va al principio de la RAM si hay un rango que la cubra, si no a una
+    // página de solo lectura propia
+    if (romSize_m == sharedSize) {
+        return;
+    }
+
+    const auto tail{ roms_m.back()->data().last(romSize_m - sharedSize) };
+
+    if (!ramRanges.empty() && ramRanges.front().first == sharedSize) {
+        std::copy(tail.begin(), tail.end(), ram_m.begin());
+        return;
+    }
+
+    romTail_m = std::make_unique<std::array<uint8_t, MemoryBus::Page_Size>>();
+    romTail_m->fill(MemoryBus::Open_Bus_Value);
+    std::copy(tail.begin(), tail.end(), romTail_m->begin());
+    bus.mapROMBank(static_cast<uint16_t>(sharedSize), static_cast<uint16_t>(sharedSize + MemoryBus::Page_Size - 1), *romTail_m);
 }
@@ -0,0 +1,763 @@
+#include "JitCompiler.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <sys/mman.h>
+#include "FlagsTables.hpp"
+
+static_assert(offsetof(JitState, registers) == 0);
+static_assert(offsetof(JitState, sp) == 8);
+static_assert(offsetof(JitState, pc) == 10);
+static_assert(offsetof(JitState, read) == 24);
+static_assert(offsetof(JitState, write) == 32);
+
+/// @brief Ensamblador mínimo de x86-64 con las instrucciones que usa el JIT
+class X86Emitter {
+public:
+    // Registros de la máquina
+    static constexpr uint8_t RAX{ 0 };
+    static constexpr uint8_t RCX{ 1 };
+    static constexpr uint8_t RDX{ 2 };
+    static constexpr uint8_t RBX{ 3 };
+    static constexpr uint8_t RSI{ 6 };
+    static constexpr uint8_t RDI{ 7 };
+
+    // Registros del 8080 dentro de un bloque
+    static constexpr uint8_t Register_A{ 14 };
+    static constexpr uint8_t Register_F{ 15 };
+
+    static constexpr uint8_t State_SP{ offsetof(JitState, sp) };
+    static constexpr uint8_t State_PC{ offsetof(JitState, pc) };
+    static constexpr uint8_t State_CPU{ offsetof(JitState, cpu) };
+    static constexpr uint8_t State_Read{ offsetof(JitState, read) };
+    static constexpr uint8_t State_Write{ offsetof(JitState, write) };
+
+    /// @brief Registro de la máquina asignado a un registro del 8080 según su codificación SSS/DDD
+    /// @param encoded Codificación del registro, M (6) no es válido
+    /// @return Registro de la máquina entre r8 y r14
+    static constexpr uint8_t hostRegister(uint8_t encoded) noexcept {
+        return encoded == 7 ? Register_A : 8 + encoded;
+    }
+
+    [[nodiscard]]
+    std::vector<uint8_t>& code() noexcept { return code_m; }
+
+    [[nodiscard]]
+    size_t size() const noexcept { return code_m.size(); }
+
+    void byte(uint8_t value) { code_m.push_back(value); }
+
+    void word(uint16_t value) {
+        byte(getLowBytes(value));
+        byte(getHighByte(value));
+    }
+
+    void dword(uint32_t value) {
+        for (uint8_t i{ 0 }; i < 4; ++i) {
+            byte(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    /// @brief Prefijo REX, se emite siempre en operaciones de 8 bits para acceder a sil/dil y r8b-r15b
+    void rex(bool w, uint8_t reg, uint8_t rm) {
+        byte(0x40 | (w << 3) | ((reg >> 3) << 2) | (rm >> 3));
+    }
+
+    void modrm(uint8_t mod, uint8_t reg, uint8_t rm) {
+        byte((mod << 6) | ((reg & 7) << 3) | (rm & 7));
+    }
+
+    /// @brief op r/m8, r8 (ADD, ADC, SUB, SBB, AND, XOR, OR, CMP y MOV)
+    void op8(uint8_t opcode, uint8_t destination, uint8_t source) {
+        rex(false, source, destination);
+        byte(opcode);
+        modrm(3, source, destination);
+    }
+
+    /// @brief op r/m8, imm8 del grupo 0x80
+    void op8Immediate(uint8_t digit, uint8_t destination, uint8_t value) {
+        rex(false, 0, destination);
+        byte(0x80);
+        modrm(3, digit, destination);
+        byte(value);
+    }
+
+    /// @brief Instrucciones de un operando de 8 bits de los grupos 0xD0 (rotaciones), 0xF6 y 0xFE (INC/DEC)
+    void unary8(uint8_t opcode, uint8_t digit, uint8_t destination) {
+        rex(false, 0, destination);
+        byte(opcode);
+        modrm(3, digit, destination);
+    }
+
+    void movImmediate8(uint8_t destination, uint8_t value) {
+        rex(false, 0, destination);
+        byte(0xB0 + (destination & 7));
+        byte(value);
+    }
+
+    void movImmediate32(uint8_t destination, uint32_t value) {
+        if (destination >= 8) {
+            rex(false, 0, destination);
+        }
+        byte(0xB8 + (destination & 7));
+        dword(value);
+    }
+
+    /// @brief movzx r32, r8
+    void movzx8(uint8_t destination, uint8_t source) {
+        rex(false, destination, source);
+        byte(0x0F);
+        byte(0xB6);
+        modrm(3, destination, source);
+    }
+
+    /// @brief movzx r32, byte [rbx + displacement]
+    void loadState8(uint8_t destination, uint8_t displacement) {
+        rex(false, destination, RBX);
+        byte(0x0F);
+        byte(0xB6);
+        modrm(1, destination, RBX);
+        byte(displacement);
+    }
+
+    /// @brief mov byte [rbx + displacement], r8
+    void storeState8(uint8_t displacement, uint8_t source) {
+        rex(false, source, RBX);
+        byte(0x88);
+        modrm(1, source, RBX);
+        byte(displacement);
+    }
+
+    /// @brief movzx r32, word [rbx + displacement]
+    void loadState16(uint8_t destination, uint8_t displacement) {
+        byte(0x0F);
+        byte(0xB7);
+        modrm(1, destination, RBX);
+        byte(displacement);
+    }
+
+    /// @brief mov word [rbx + displacement], r16
+    void storeState16(uint8_t displacement, uint8_t source) {
+        byte(0x66);
+        byte(0x89);
+        modrm(1, source, RBX);
+        byte(displacement);
+    }
+
+    /// @brief mov word [rbx + displacement], imm16
+    void storeStateImmediate16(uint8_t displacement, uint16_t value) {
+        byte(0x66);
+        byte(0xC7);
+        modrm(1, 0, RBX);
+        byte(displacement);
+        word(value);
+    }
+
+    /// @brief inc/dec word [rbx + displacement]
+    void unaryState16(uint8_t digit, uint8_t displacement) {
+        byte(0x66);
+        byte(0xFF);
+        modrm(1, digit, RBX);
+        byte(displacement);
+    }
+
+    /// @brief op r/m32, r32 (0x01 ADD, 0x09 OR, 0x89 MOV, 0x87 XCHG)
+    void op32(uint8_t opcode, uint8_t destination, uint8_t source) {
+        rex(false, source, destination);
+        byte(opcode);
+        modrm(3, source, destination);
+    }
+
+    /// @brief Grupo 0x83 con imm8 extendido en signo (/1 OR, /4 AND, /6 XOR)
+    void op32Immediate8(uint8_t digit, uint8_t destination, int8_t value) {
+        rex(false, 0, destination);
+        byte(0x83);
+        modrm(3, digit, destination);
+        byte(static_cast<uint8_t>(value));
+    }
+
+    /// @brief and r32, imm32
+    void and32(uint8_t destination, uint32_t value) {
+        rex(false, 0, destination);
+        byte(0x81);
+        modrm(3, 4, destination);
+        dword(value);
+    }
+
+    /// @brief Grupo 0xC1 de desplazamientos (/4 SHL, /5 SHR)
+    void shift32(uint8_t digit, uint8_t destination, uint8_t count) {
+        rex(false, 0, destination);
+        byte(0xC1);
+        modrm(3, digit, destination);
+        byte(count);
+    }
+
+    /// @brief inc/dec r32
+    void unary32(uint8_t digit, uint8_t destination) {
+        rex(false, 0, destination);
+        byte(0xFF);
+        modrm(3, digit, destination);
+    }
+
+    /// @brief bt r32, imm8
+    void bitTest(uint8_t destination, uint8_t bit) {
+        rex(false, 0, destination);
+        byte(0x0F);
+        byte(0xBA);
+        modrm(3, 4, destination);
+        byte(bit);
+    }
+
+    /// @brief setc al seguido de movzx eax, al
+    void carryToEAX() {
+        byte(0x0F);
+        byte(0x92);
+        modrm(3, 0, RAX);
+        movzx8(RAX, RAX);
+    }
+
+    void push(uint8_t reg) {
+        if (reg >= 8) {
+            byte(0x41);
+        }
+        byte(0x50 + (reg & 7));
+    }
+
+    void pop(uint8_t reg) {
+        if (reg >= 8) {
+            byte(0x41);
+        }
+        byte(0x58 + (reg & 7));
+    }
+
+    /// @brief pushfq seguido de pop reg
+    void flagsTo(uint8_t reg) {
+        byte(0x9C);
+        pop(reg);
+    }
+
+    /// @brief call qword [rbx + displacement]
+    void callState(uint8_t displacement) {
+        byte(0xFF);
+        modrm(1, 2, RBX);
+        byte(displacement);
+    }
+
+    /// @brief jmp rel32, devuelve la posición del desplazamiento para parchearlo
+    size_t jump() {
+        byte(0xE9);
+        dword(0);
+        return size() - 4;
+    }
+
+    void patch(size_t position, size_t target) {
+        const auto relative{ static_cast<uint32_t>(target - (position + 4)) };
+        std::memcpy(code_m.data() + position, &relative, sizeof(relative));
+    }
+
+private:
+    std::vector<uint8_t> code_m;
+};
+
+/// @brief Traduce las instrucciones de un bloque sobre un X86Emitter
+class BlockTranslator {
+public:
+    explicit BlockTranslator(const BlockCache::Block& block) : block_m{ block } { }
+
+    /// @brief Genera el código del prefijo soportado del bloque
+    /// @return Número de operaciones traducidas
+    uint8_t translate();
+
+    [[nodiscard]]
+    std::vector<uint8_t>& code() noexcept { return emitter_m.code(); }
+
+private:
+    static constexpr uint8_t Flags_SZACP{ Flags_SZACPCY & ~Flag_CY };
+    static constexpr uint8_t Flags_SZP_Mask{ Flag_S | Flag_Z | Flag_P };
+
+    /// @brief Opcodes x86 de op r/m8, r8 y dígitos del grupo 0x80 para ADD, ADC, SUB, SBB, ANA, XRA, ORA y CMP
+    static constexpr std::array<uint8_t, 8> Alu_Opcodes{ 0x00, 0x10, 0x28, 0x18, 0x20, 0x30, 0x08, 0x38 };
+    static constexpr std::array<uint8_t, 8> Alu_Digits{ 0, 2, 5, 3, 4, 6, 1, 7 };
+
+    const BlockCache::Block& block_m;
+    X86Emitter emitter_m;
+
+    uint32_t address_m{ 0 };
+    std::vector<size_t> exits_m;
+
+    void prologue();
+    void epilogue();
+
+    /// @brief Traduce una instrucción
+    /// @return false si el opcode no está soportado
+    bool translate(const BlockCache::Operation& operation);
+
+    /// @brief Termina el bloque con el pc y los ciclos dados
+    void exit(uint16_t pc, uint32_t cycles);
+
+    /// @brief Copia los bits indicados de RFLAGS al registro F
+    /// @param mask Flags que se copian
+    /// @param cleared Flags que se limpian antes de copiar, por defecto los mismos que se copian
+    /// @param scratch Registro auxiliar
+    void mergeFlags(uint8_t mask, uint8_t cleared, uint8_t scratch = X86Emitter::RAX);
+
+    /// @brief Carga un par de registros (o SP) en un registro de 32 bits
+    void loadPair(uint8_t destination, uint8_t rp);
+
+    /// @brief Guarda esi en un par de registros (o SP)
+    void storePair(uint8_t rp);
+
+    /// @brief Llama a la lectura de memoria con la dirección en esi, deja el byte en al
+    void callRead();
+
+    /// @brief Llama a la escritura de memoria con la dirección en esi y el valor en edx,
+    /// sale del bloque si la escritura invalida código
+    void callWrite(const BlockCache::Operation& operation);
+
+    void alu(uint8_t operation, uint8_t source);
+    void aluImmediate(uint8_t operation, uint8_t value);
+    void aluFlags(uint8_t operation);
+};
+
+uint8_t BlockTranslator::translate() {
+    prologue();
+
+    address_m = block_m.start;
+    uint8_t translated{ 0 };
+
+    for (const auto& operation : block_m.operations) {
+        if (!translate(operation)) {
+            break;
+        }
+
+        ++translated;
+
+        if (operation.opcode == 0xC3 || operation.opcode == 0xCB) {
+            exit(operation.operand, operation.cyclesUntil);
+            break;
+        }
+    }
+
+    if (translated == 0) {
+        return 0;
+    }
+
+    const auto& last{ block_m.operations[translated - 1] };
+
+    if (last.opcode != 0xC3 && last.opcode != 0xCB) {
+        exit(static_cast<uint16_t>(address_m), last.cyclesUntil);
+    }
+
+    const auto epilogueStart{ emitter_m.size() };
+    epilogue();
+
+    for (const auto position : exits_m) {
+        emitter_m.patch(position, epilogueStart);
+    }
+
+    return translated;
+}
+
+void BlockTranslator::prologue() {
+    emitter_m.push(X86Emitter::RBX);
+    emitter_m.push(5);
+    for (uint8_t reg{ 12 }; reg <= 15; ++reg) {
+        emitter_m.push(reg);
+    }
+
+    // sub rsp, 8 para que las llamadas encuentren la pila alineada a 16 bytes
+    emitter_m.byte(0x48); emitter_m.byte(0x83); emitter_m.byte(0xEC); emitter_m.byte(0x08);
+
+    // mov rbx, rdi
+    emitter_m.byte(0x48); emitter_m.byte(0x89); emitter_m.byte(0xFB);
+
+    for (uint8_t i{ 0 }; i < 8; ++i) {
+        emitter_m.loadState8(8 + i, i);
+    }
+}
+
+void BlockTranslator::epilogue() {
+    for (uint8_t i{ 0 }; i < 8; ++i) {
+        emitter_m.storeState8(i, 8 + i);
+    }
+
+    // add rsp, 8
+    emitter_m.byte(0x48); emitter_m.byte(0x83); emitter_m.byte(0xC4); emitter_m.byte(0x08);
+
+    for (uint8_t reg{ 15 }; reg >= 12; --reg) {
+        emitter_m.pop(reg);
+    }
+    emitter_m.pop(5);
+    emitter_m.pop(X86Emitter::RBX);
+
+    emitter_m.byte(0xC3);
+}
+
+void BlockTranslator::exit(uint16_t pc, uint32_t cycles) {
+    emitter_m.storeStateImmediate16(X86Emitter::State_PC, pc);
+    emitter_m.movImmediate32(X86Emitter::RAX, cycles);
+    exits_m.push_back(emitter_m.jump());
+}
+
+void BlockTranslator::mergeFlags(uint8_t mask, uint8_t cleared, uint8_t scratch) {
+    emitter_m.flagsTo(scratch);
+    emitter_m.and32(scratch, mask);
+    emitter_m.and32(X86Emitter::Register_F, ~static_cast<uint32_t>(cleared));
+    emitter_m.op32(0x09, X86Emitter::Register_F, scratch);
+}
+
+void BlockTranslator::loadPair(uint8_t destination, uint8_t rp) {
+    if (rp == 3) {
+        emitter_m.loadState16(destination, X86Emitter::State_SP);
+        return;
+    }
+
+    emitter_m.movzx8(destination, 8 + rp * 2);
+    emitter_m.shift32(4, destination, 8);
+    emitter_m.op32(0x09, destination, 8 + rp * 2 + 1);
+}
+
+void BlockTranslator::storePair(uint8_t rp) {
+    if (rp == 3) {
+        emitter_m.storeState16(X86Emitter::State_SP, X86Emitter::RSI);
+        return;
+    }
+
+    emitter_m.op8(0x88, 8 + rp * 2 + 1, X86Emitter::RSI);
+    emitter_m.shift32(5, X86Emitter::RSI, 8);
+    emitter_m.op8(0x88, 8 + rp * 2, X86Emitter::RSI);
+}
+
+void BlockTranslator::callRead() {
+    // r8-r11 no se preservan entre llamadas
+    for (uint8_t reg{ 8 }; reg <= 11; ++reg) {
+        emitter_m.push(reg);
+    }
+
+    // mov rdi, [rbx + cpu]
+    emitter_m.byte(0x48); emitter_m.byte(0x8B); emitter_m.modrm(1, X86Emitter::RDI, X86Emitter::RBX); emitter_m.byte(X86Emitter::State_CPU);
+    emitter_m.callState(X86Emitter::State_Read);
+
+    for (uint8_t reg{ 11 }; reg >= 8; --reg) {
+        emitter_m.pop(reg);
+    }
+}
+
+void BlockTranslator::callWrite(const BlockCache::Operation& operation) {
+    for (uint8_t reg{ 8 }; reg <= 11; ++reg) {
+        emitter_m.push(reg);
+    }
+
+    emitter_m.byte(0x48); emitter_m.byte(0x8B); emitter_m.modrm(1, X86Emitter::RDI, X86Emitter::RBX); emitter_m.byte(X86Emitter::State_CPU);
+    emitter_m.callState(X86Emitter::State_Write);
+
+    for (uint8_t reg{ 11 }; reg >= 8; --reg) {
+        emitter_m.pop(reg);
+    }
+
+    // test al, al; jz sobre la salida
+    emitter_m.byte(0x84); emitter_m.byte(0xC0);
+    emitter_m.byte(0x74);
+    const auto skip{ emitter_m.size() };
+    emitter_m.byte(0);
+
+    exit(static_cast<uint16_t>(address_m), operation.cyclesUntil);
+    emitter_m.code()[skip] = static_cast<uint8_t>(emitter_m.size() - (skip + 1));
+}
+
+void BlockTranslator::aluFlags(uint8_t operation) {
+    if (operation >= 4 && operation <= 6) {
+        // ANA, XRA y ORA limpian CY, y AC solo queda activo con ANA
+        mergeFlags(Flags_SZP_Mask, Flags_SZACPCY);
+        if (operation == 4) {
+            emitter_m.op32Immediate8(1, X86Emitter::Register_F, Flag_AC);
+        }
+    }
+    else {
+        mergeFlags(Flags_SZACPCY, Flags_SZACPCY);
+    }
+}
+
+void BlockTranslator::alu(uint8_t operation, uint8_t source) {
+    if (operation == 1 || operation == 3) {
+        emitter_m.bitTest(X86Emitter::Register_F, 0);
+    }
+
+    emitter_m.op8(Alu_Opcodes[operation], X86Emitter::Register_A, source);
+    aluFlags(operation);
+}
+
+void BlockTranslator::aluImmediate(uint8_t operation, uint8_t value) {
+    if (operation == 1 || operation == 3) {
+        emitter_m.bitTest(X86Emitter::Register_F, 0);
+    }
+
+    emitter_m.op8Immediate(Alu_Digits[operation], X86Emitter::Register_A, value);
+    aluFlags(operation);
+}
+
+bool BlockTranslator::translate(const BlockCache::Operation& operation) {
+    const uint8_t opcode{ operation.opcode };
+    const uint8_t ddd = (opcode >> 3) & 0b111;
+    const uint8_t sss = opcode & 0b111;
+    const uint8_t rp = (opcode >> 4) & 0b11;
+    const uint8_t operand8{ getLowBytes(operation.operand) };
+
+    if (!JitCompiler::supports(opcode)) {
+        return false;
+    }
+
+    uint8_t length{ 1 };
+
+    switch (opcode >> 6) {
+    case 0b00:
+        switch (sss) {
+        case 0b000:
+            break;                                                          // NOP
+
+        case 0b001:
+            if ((opcode & 0b1000) == 0) {                                   // LXI
+                length = 3;
+                if (rp == 3) {
+                    emitter_m.storeStateImmediate16(X86Emitter::State_SP, operation.operand);
+                }
+                else {
+                    emitter_m.movImmediate8(8 + rp * 2, getHighByte(operation.operand));
+                    emitter_m.movImmediate8(8 + rp * 2 + 1, operand8);
+                }
+            }
+            else {                                                          // DAD
+                loadPair(X86Emitter::RSI, 2);
+                loadPair(X86Emitter::RDI, rp);
+                emitter_m.op32(0x01, X86Emitter::RSI, X86Emitter::RDI);
+                emitter_m.bitTest(X86Emitter::RSI, 16);
+                emitter_m.carryToEAX();
+                emitter_m.op32Immediate8(4, X86Emitter::Register_F, ~1);
+                emitter_m.op32(0x09, X86Emitter::Register_F, X86Emitter::RAX);
+                storePair(2);
+            }
+            break;
+
+        case 0b010: {
+            // STAX, LDAX, STA y LDA
+            const bool load{ (opcode & 0b1000) != 0 };
+
+            if (rp < 2) {
+                loadPair(X86Emitter::RSI, rp);
+            }
+            else {
+                length = 3;
+                emitter_m.movImmediate32(X86Emitter::RSI, operation.operand);
+            }
+
+            address_m += length;
+
+            if (load) {
+                callRead();
+                emitter_m.op8(0x88, X86Emitter::Register_A, X86Emitter::RAX);
+            }
+            else {
+                emitter_m.movzx8(X86Emitter::RDX, X86Emitter::Register_A);
+                callWrite(operation);
+            }
+            return true;
+        }
+
+        case 0b011:                                                         // INX y DCX
+            if (rp == 3) {
+                emitter_m.unaryState16((opcode & 0b1000) == 0 ? 0 : 1, X86Emitter::State_SP);
+            }
+            else {
+                loadPair(X86Emitter::RSI, rp);
+                emitter_m.unary32((opcode & 0b1000) == 0 ? 0 : 1, X86Emitter::RSI);
+                storePair(rp);
+            }
+            break;
+
+        case 0b100:
+        case 0b101: {                                                       // INR y DCR
+            const uint8_t digit{ static_cast<uint8_t>(sss == 0b100 ? 0 : 1) };
+
+            if (ddd != 6) {
+                emitter_m.unary8(0xFE, digit, X86Emitter::hostRegister(ddd));
+                mergeFlags(Flags_SZACP, Flags_SZACP);
+                break;
+            }
+
+            address_m += length;
+
+            loadPair(X86Emitter::RSI, 2);
+            callRead();
+            emitter_m.unary8(0xFE, digit, X86Emitter::RAX);
+            mergeFlags(Flags_SZACP, Flags_SZACP, X86Emitter::RCX);
+            emitter_m.movzx8(X86Emitter::RDX, X86Emitter::RAX);
+            loadPair(X86Emitter::RSI, 2);
+            callWrite(operation);
+            return true;
+        }
+
+        case 0b110:                                                         // MVI
+            length = 2;
+            if (ddd != 6) {
+                emitter_m.movImmediate8(X86Emitter::hostRegister(ddd), operand8);
+                break;
+            }
+
+            address_m += length;
+
+            loadPair(X86Emitter::RSI, 2);
+            emitter_m.movImmediate32(X86Emitter::RDX, operand8);
+            callWrite(operation);
+            return true;
+
+        default:
+            switch (ddd) {
+            case 0:                                                         // RLC
+            case 1:                                                         // RRC
+            case 2:                                                         // RAL
+            case 3:                                                         // RAR
+                if (ddd >= 2) {
+                    emitter_m.bitTest(X86Emitter::Register_F, 0);
+                }
+                emitter_m.unary8(0xD0, ddd, X86Emitter::Register_A);
+                emitter_m.carryToEAX();
+                emitter_m.op32Immediate8(4, X86Emitter::Register_F, ~1);
+                emitter_m.op32(0x09, X86Emitter::Register_F, X86Emitter::RAX);
+                break;
+            case 5:                                                         // CMA
+                emitter_m.unary8(0xF6, 2, X86Emitter::Register_A);
+                break;
+            case 6:                                                         // STC
+                emitter_m.op32Immediate8(1, X86Emitter::Register_F, 1);
+                break;
+            case 7:                                                         // CMC
+                emitter_m.op32Immediate8(6, X86Emitter::Register_F, 1);
+                break;
+            }
+            break;
+        }
+        break;
+
+    case 0b01:                                                              // MOV
+        if (ddd == 6) {
+            address_m += length;
+
+            loadPair(X86Emitter::RSI, 2);
+            emitter_m.movzx8(X86Emitter::RDX, X86Emitter::hostRegister(sss));
+            callWrite(operation);
+            return true;
+        }
+
+        if (sss == 6) {
+            loadPair(X86Emitter::RSI, 2);
+            callRead();
+            emitter_m.op8(0x88, X86Emitter::hostRegister(ddd), X86Emitter::RAX);
+        }
+        else {
+            emitter_m.op8(0x88, X86Emitter::hostRegister(ddd), X86Emitter::hostRegister(sss));
+        }
+        break;
+
+    case 0b10:                                                              // ALU con registro o M
+        if (sss == 6) {
+            loadPair(X86Emitter::RSI, 2);
+            callRead();
+            alu(ddd, X86Emitter::RAX);
+        }
+        else {
+            alu(ddd, X86Emitter::hostRegister(sss));
+        }
+        break;
+
+    default:
+        if (opcode == 0xEB) {                                               // XCHG
+            emitter_m.op32(0x87, 10, 12);
+            emitter_m.op32(0x87, 11, 13);
+        }
+        else if (sss == 0b110) {                                            // ALU inmediata
+            length = 2;
+            aluImmediate(ddd, operand8);
+        }
+        else {                                                              // JMP
+            length = 3;
+        }
+        break;
+    }
+
+    address_m += length;
+    return true;
+}
+
+JitCompiler::JitCompiler() {
+    void* buffer{ mmap(nullptr, Buffer_Size, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+
+    if (buffer == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+
+    buffer_m = static_cast<uint8_t*>(buffer);
+}
+
+JitCompiler::~JitCompiler() {
+    munmap(buffer_m, Buffer_Size);
+}
+
+bool JitCompiler::compile(BlockCache::Block& block) {
+    BlockTranslator translator{ block };
+    const auto translated{ translator.translate() };
+
+    if (translated == 0) {
+        return false;
+    }
+
+    const auto& code{ translator.code() };
+
+    if (!executable_m || used_m + code.size() > Buffer_Size) {
+        return false;
+    }
+
+    // El buffer solo es escribible mientras se copia el bloque. Una política W^X puede negar el cambio, en ese caso
+    // el bloque sigue en el intérprete
+    if (mprotect(buffer_m, Buffer_Size, PROT_READ | PROT_WRITE) != 0) {
+        return false;
+    }
+
+    std::memcpy(buffer_m + used_m, code.data(), code.size());
+
+    // Sin la vuelta a ejecutable no puede correr ni este bloque ni los que ya se habían compilado
+    if (mprotect(buffer_m, Buffer_Size, PROT_READ | PROT_EXEC) != 0) {
+        executable_m = false;
+        return false;
+    }
+
+    block.native = reinterpret_cast<BlockCache::NativeCode>(buffer_m + used_m);
+    block.nativeOperations = translated;
+
+    // Cada bloque empieza alineado a 16 bytes
+    used_m = (used_m + code.size() + 15) & ~size_t{ 15 };
+
+    return true;
+}
+
+void JitCompiler::reset() noexcept {
+    used_m = 0;
+}
+
+bool JitCompiler::supports(uint8_t opcode) noexcept {
+    switch (opcode >> 6) {
+    case 0b00:
+        // SHLD, LHLD y DAA se quedan en el intérprete
+        return opcode != 0x22 && opcode != 0x2A && opcode != 0x27;
+
+    case 0b01:
+        return opcode != 0x76;
+
+    case 0b10:
+        return true;
+
+    default:
+        return opcode == 0xC3 || opcode == 0xCB || opcode == 0xEB || (opcode & 0b111) == 0b110;
+    }
+}
@@ -0,0 +1,140 @@
+#include "RomImage.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FAKE8080_ROM_MMAP
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#include "AotProgram.hpp"
+
+std::shared_ptr<const RomImage> RomImage::open(std::string_view path) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::weak_ptr<const RomImage>> imagesByPath;
+    static std::unordered_map<uint64_t, std::weak_ptr<const RomImage>> imagesByHash;
+
+    const std::lock_guard lock{ mutex };
+    std::string key{ path };
+
+    if (auto image{ imagesByPath[key].lock() }) {
+        return image;
+    }
+
+    std::shared_ptr<RomImage> loaded{ load(path) };
+    loaded->hash_m = AotProgram::hash(loaded->data());
+
+    // La misma ROM desde otra ruta reutiliza la imagen existente y la recién cargada se libera
+    std::shared_ptr<const RomImage> image{ imagesByHash[loaded->hash_m].lock() };
+
+    if (!image || !std::ranges::equal(image->data(), loaded->data())) {
+        image = std::move(loaded);
+        imagesByHash[image->hash()] = image;
+    }
+
+    // Una tubería no se puede volver a leer por ruta, solo se registran por ruta las imágenes proyectadas
+    if (image->isMapped()) {
+        imagesByPath[std::move(key)] = image;
+    }
+    else {
+        imagesByPath.erase(key);
+    }
+
+    return image;
+}
+
+RomImage::~RomImage() {
+#if defined(FAKE8080_ROM_MMAP)
+    if (mapped_m != nullptr) {
+        munmap(const_cast<uint8_t*>(mapped_m), mappedSize_m);
+    }
+#endif
+}
+
+#if defined(FAKE8080_ROM_MMAP)
+
+std::shared_ptr<RomImage> RomImage::load(std::string_view path) {
+    const std::string pathString{ path };
+    const int file{ ::open(pathString.c_str(), O_RDONLY | O_CLOEXEC) };
+
+    if (file < 0) {
+        throw std::runtime_error{ "Cant open ROM file" };
+    }
+
+    std::shared_ptr<RomImage> image{ new RomImage{} };
+    struct stat status{};
+
+    if (fstat(file, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+        const auto size{ static_cast<size_t>(status.st_size) };
+        void* mapped{ mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0) };
+
+        if (mapped != MAP_FAILED) {
+            close(file);
+            image->mapped_m = static_cast<const uint8_t*>(mapped);
+            image->mappedSize_m = size;
+            return image;
+        }
+    }
+
+    auto& buffer{ image->buffer_m };
+
+    for (;;) {
+        const auto offset{ buffer.size() };
+        buffer.resize(offset + Read_Block_Size);
+
+        const auto bytesRead{ ::read(file, buffer.data() + offset, Read_Block_Size) };
+
+        if (bytesRead < 0 && errno == EINTR) {
+            buffer.resize(offset);
+            continue;
+        }
+
+        if (bytesRead < 0) {
+            close(file);
+            throw std::runtime_error{ "Cant read ROM file" };
+        }
+
+        buffer.resize(offset + static_cast<size_t>(bytesRead));
+
+        if (bytesRead == 0) {
+            break;
+        }
+    }
+
+    close(file);
+    return image;
+}
+
+#else
+
+std::shared_ptr<RomImage> RomImage::load(std::string_view path) {
+    std::ifstream file{ std::string{ path }, std::ios::binary };
+
+    if (!file) {
+        throw std::runtime_error{ "Cant open ROM file" };
+    }
+
+    std::shared_ptr<RomImage> image{ new RomImage{} };
+    auto& buffer{ image->buffer_m };
+
+    while (file) {
+        const auto offset{ buffer.size() };
+        buffer.resize(offset + Read_Block_Size);
+        file.read(reinterpret_cast<char*>(buffer.data() + offset), Read_Block_Size);
+        buffer.resize(offset + static_cast<size_t>(file.gcount()));
+    }
+
+    return image;
+}
+
+#endif
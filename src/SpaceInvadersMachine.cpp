@@ -0,0 +1,96 @@
+#include "SpaceInvadersMachine.hpp"
+
+#include <stdexcept>
+
+SpaceInvadersMachine::SpaceInvadersMachine(std::span<const std::string_view> romPaths) : Fake8080{ romPaths, Ram_Ranges } {
+    if (romPaths.size() != Rom_Names.size() || romSize() != RAM_Start) {
+        throw std::invalid_argument{ "Space Invaders needs four 2 KiB ROMs" };
+    }
+
+    auto& ports{ cpu().portBus() };
+    ports.bindInput<&SpaceInvadersMachine::readInputs>(0, *this);
+    ports.bindInput<&SpaceInvadersMachine::readInputs>(1, *this);
+    ports.bindInput<&SpaceInvadersMachine::readInputs>(2, *this);
+    ports.bindInput<&SpaceInvadersMachine::readShiftRegister>(3, *this);
+    ports.bindOutput<&SpaceInvadersMachine::writeShiftOffset>(2, *this);
+    ports.bindOutput<&SpaceInvadersMachine::writeShiftData>(4, *this);
+
+    // Sonido (3 y 5) y watchdog (6) no tienen efecto sin audio, sus escrituras se ignoran
+    auto& scheduler{ cpu().scheduler() };
+    midScreenEvent_m = scheduler.schedule(Mid_Screen_Cycles, &SpaceInvadersMachine::midScreen, this);
+    vblankEvent_m = scheduler.schedule(Cycles_Per_Frame, &SpaceInvadersMachine::vblank, this);
+}
+
+void SpaceInvadersMachine::setInput(Input input, bool pressed) noexcept {
+    struct Bit {
+        uint8_t* port;
+        uint8_t mask;
+    };
+
+    const auto bit{ [&]() -> Bit {
+        switch (input) {
+        case Input::Coin:           return { &port1_m, 1 << 0 };
+        case Input::Player2Start:   return { &port1_m, 1 << 1 };
+        case Input::Player1Start:   return { &port1_m, 1 << 2 };
+        case Input::Player1Fire:    return { &port1_m, 1 << 4 };
+        case Input::Player1Left:    return { &port1_m, 1 << 5 };
+        case Input::Player1Right:   return { &port1_m, 1 << 6 };
+        case Input::Tilt:           return { &port2Inputs_m, 1 << 2 };
+        case Input::Player2Fire:    return { &port2Inputs_m, 1 << 4 };
+        case Input::Player2Left:    return { &port2Inputs_m, 1 << 5 };
+        default:                    return { &port2Inputs_m, 1 << 6 };     // Player2Right
+        }
+    }() };
+
+    if (pressed) {
+        *bit.port |= bit.mask;
+    }
+    else {
+        *bit.port &= static_cast<uint8_t>(~bit.mask);
+    }
+}
+
+void SpaceInvadersMachine::setDipSwitches(uint8_t switches) noexcept {
+    dipSwitches_m = switches & Dip_Switches_Mask;
+}
+
+void SpaceInvadersMachine::runFrame() {
+    // El presupuesto acaba justo en el VBlank, cuyo evento run() dispara antes de volver
+    const auto end{ (frames_m + 1) * Cycles_Per_Frame };
+    const auto cycles{ cpu().getCycles() };
+
+    cpu().run(end > cycles ? end - cycles : 0);
+}
+
+uint8_t SpaceInvadersMachine::readInputs(uint8_t port) {
+    switch (port) {
+    case 0:     return Port0_Fixed_Bits;
+    case 1:     return port1_m;
+    default:    return port2Inputs_m | dipSwitches_m;
+    }
+}
+
+uint8_t SpaceInvadersMachine::readShiftRegister(uint8_t) {
+    return static_cast<uint8_t>(shiftRegister_m >> (8 - shiftOffset_m));
+}
+
+void SpaceInvadersMachine::writeShiftOffset(uint8_t, uint8_t value) {
+    shiftOffset_m = value & 0b111;
+}
+
+void SpaceInvadersMachine::writeShiftData(uint8_t, uint8_t value) {
+    shiftRegister_m = static_cast<uint16_t>(value << 8 | shiftRegister_m >> 8);
+}
+
+void SpaceInvadersMachine::midScreen(void* context, uint64_t deadline) {
+    auto& machine{ *static_cast<SpaceInvadersMachine*>(context) };
+    machine.cpu().requestInterrupt(Mid_Screen_Interrupt);
+    machine.cpu().scheduler().reschedule(machine.midScreenEvent_m, deadline + Cycles_Per_Frame);
+}
+
+void SpaceInvadersMachine::vblank(void* context, uint64_t deadline) {
+    auto& machine{ *static_cast<SpaceInvadersMachine*>(context) };
+    machine.cpu().requestInterrupt(VBlank_Interrupt);
+    machine.cpu().scheduler().reschedule(machine.vblankEvent_m, deadline + Cycles_Per_Frame);
+    ++machine.frames_m;
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "AotCompiler.hpp"
+#include <array>
+#include <sstream>
+#include <string>
+
+class AotCompilerTest : public ::testing::Test {
+protected:
+    static constexpr std::array<uint16_t, 1> Reset{ 0x0000 };
+
+    std::array<uint8_t, 0x40> rom{};
+};
+
+// ==================== Tests del análisis ====================
+
+TEST_F(AotCompilerTest, FollowsCallsAndTheirReturnSite) {
+    rom[0x00] = 0x3C;  // INR A
+    rom[0x01] = 0xCD;  // CALL 0x0010
+    rom[0x02] = 0x10;
+    rom[0x03] = 0x00;
+    rom[0x04] = 0xC3;  // JMP 0x0000
+    rom[0x05] = 0x00;
+    rom[0x06] = 0x00;
+
+    rom[0x10] = 0x04;  // INR B
+    rom[0x11] = 0xC9;  // RET
+
+    AotCompiler compiler{ rom };
+    compiler.analyze(Reset);
+
+    const auto& blocks{ compiler.blocks() };
+
+    ASSERT_EQ(blocks.size(), 3);
+    ASSERT_TRUE(blocks.contains(0x0004));
+    ASSERT_TRUE(blocks.contains(0x0010));
+
+    const auto& call{ blocks.at(0x0000) };
+    EXPECT_EQ(call.end, 0x0004);
+    EXPECT_EQ(call.bodyCycles, 5);
+    EXPECT_TRUE(call.terminated);
+    EXPECT_EQ(call.successors, (std::vector<uint16_t>{ 0x0010, 0x0004 }));
+
+    // RET es un salto indirecto, su destino se resuelve en ejecución
+    EXPECT_TRUE(blocks.at(0x0010).successors.empty());
+
+    // Después de un JMP no se sigue la instrucción siguiente
+    EXPECT_EQ(blocks.at(0x0004).successors, (std::vector<uint16_t>{ 0x0000 }));
+}
+
+TEST_F(AotCompilerTest, CodeOutsideImageIsNotTranslated) {
+    rom[0x00] = 0xC3;  // JMP 0x8000
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x80;
+
+    rom[0x3E] = 0x21;  // LXI H, cortado por el final de la imagen
+
+    AotCompiler compiler{ rom };
+    compiler.analyze(std::array<uint16_t, 2>{ 0x0000, 0x003E });
+
+    ASSERT_EQ(compiler.blocks().size(), 1);
+    EXPECT_TRUE(compiler.blocks().contains(0x0000));
+}
+
+TEST_F(AotCompilerTest, StraightLineCodeReachesTheEndOfImage) {
+    AotCompiler compiler{ rom };
+    compiler.analyze(Reset);
+
+    const auto& blocks{ compiler.blocks() };
+
+    ASSERT_EQ(blocks.size(), 1);
+    EXPECT_EQ(blocks.at(0x0000).end, rom.size());
+    EXPECT_FALSE(blocks.at(0x0000).terminated);
+    EXPECT_TRUE(blocks.at(0x0000).successors.empty());
+}
+
+TEST_F(AotCompilerTest, MemoryWritesAreDetected) {
+    for (uint8_t opcode : { 0x02, 0x12, 0x22, 0x32, 0x34, 0x35, 0x36, 0x70, 0x77, 0xC5, 0xF5, 0xE3 }) {
+        EXPECT_TRUE(AotCompiler::writesMemory(opcode)) << "Opcode " << static_cast<int>(opcode);
+    }
+
+    for (uint8_t opcode : { 0x00, 0x0A, 0x2A, 0x3A, 0x46, 0x76, 0x7E, 0x86, 0xC1, 0xEB }) {
+        EXPECT_FALSE(AotCompiler::writesMemory(opcode)) << "Opcode " << static_cast<int>(opcode);
+    }
+}
+
+// ==================== Tests de la generación ====================
+
+TEST_F(AotCompilerTest, EmitsOneFunctionPerBlock) {
+    rom[0x00] = 0x32;  // STA 0x2000
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x20;
+    rom[0x03] = 0xC3;  // JMP 0x0000
+    rom[0x04] = 0x00;
+    rom[0x05] = 0x00;
+
+    AotCompiler compiler{ rom };
+    compiler.analyze(Reset);
+
+    std::ostringstream output;
+    compiler.emit(output, "test_program");
+    const auto code{ output.str() };
+
+    EXPECT_NE(code.find("#include \"AotRuntime.hpp\""), std::string::npos);
+    EXPECT_NE(code.find("static uint32_t block_0000(CPU& cpu)"), std::string::npos);
+    EXPECT_NE(code.find("AotRuntime::execute<0x32>(cpu);"), std::string::npos);
+    EXPECT_NE(code.find("return 13 + AotRuntime::execute<0xC3>(cpu);"), std::string::npos);
+    EXPECT_NE(code.find("{ 0x0000, 0x0006, 13, true, &block_0000 }"), std::string::npos);
+    EXPECT_NE(code.find("const AotProgram test_program{ Blocks, 64, "), std::string::npos);
+
+    // La escritura puede modificar el propio bloque, que termina si lo hace
+    EXPECT_NE(code.find("if (AotRuntime::codeModified(cpu)) [[unlikely]]"), std::string::npos);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include "Fake8080.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// Generado por fake8080_aot a partir de test/roms/aot_test.rom
+extern const AotProgram aot_test_program;
+
+class AotRunTest : public ::testing::Test {
+protected:
+    CPUTest cpu;
+    CPUTest reference;
+    std::array<uint8_t, 65536> rom{};
+    std::array<uint8_t, 65536> referenceRom{};
+
+    void SetUp() override {
+        std::ifstream romFile{ FAKE8080_AOT_TEST_ROM, std::ios::binary };
+        ASSERT_TRUE(romFile);
+
+        const std::vector<uint8_t> image{ std::istreambuf_iterator<char>{ romFile }, std::istreambuf_iterator<char>{} };
+        std::copy(image.begin(), image.end(), rom.begin());
+        referenceRom = rom;
+
+        cpu.setROM(rom);
+        cpu.setProgram(aot_test_program);
+
+        // Sin programa el backend AOT interpreta todas las instrucciones
+        reference.setROM(referenceRom);
+    }
+};
+
+// ==================== Tests de la ejecución ====================
+
+TEST_F(AotRunTest, MatchesSingleStepExecution) {
+    for (uint64_t budget : { 1, 10, 50, 333, 1'000, 4'096, 100'000 }) {
+        const auto cycles{ cpu.run(budget) };
+
+        uint64_t referenceCycles{ 0 };
+        while (referenceCycles < budget) {
+            referenceCycles += reference.cycle();
+        }
+
+        EXPECT_EQ(cycles, referenceCycles);
+        EXPECT_EQ(cpu.pc_m, reference.pc_m);
+
+        for (auto pair : { Registers::CombinedRegister::BC, Registers::CombinedRegister::DE, Registers::CombinedRegister::HL,
+                           Registers::CombinedRegister::SP, Registers::CombinedRegister::PSW }) {
+            EXPECT_EQ(cpu.registers_m.getCombinedRegister(pair), reference.registers_m.getCombinedRegister(pair));
+        }
+
+        EXPECT_TRUE(rom == referenceRom);
+    }
+}
+
+TEST_F(AotRunTest, ModifiedBlocksFallBackToInterpreter) {
+    ASSERT_NE(cpu.programBlocks_m[0x0000], nullptr);
+    ASSERT_NE(cpu.programBlocks_m[0x001E], nullptr);
+    ASSERT_NE(cpu.programBlocks_m[0x0020], nullptr);
+
+    cpu.run(1'000);
+
+    // STA 0x0023 reescribe el operando del MVI C de su propio bloque, y de los que empiezan en un vector de RST y lo contienen
+    EXPECT_EQ(cpu.programBlocks_m[0x001E], nullptr);
+    EXPECT_EQ(cpu.programBlocks_m[0x0020], nullptr);
+    EXPECT_NE(cpu.programBlocks_m[0x0000], nullptr);
+
+    // El código que el programa copia a RAM no está traducido
+    EXPECT_EQ(cpu.programBlocks_m[0x4000], nullptr);
+}
+
+TEST_F(AotRunTest, IOPageHandlersSeeCyclesInsideBlock) {
+    struct Device {
+        CPUTest* cpu;
+        std::vector<uint64_t> accesses;
+        uint64_t eventCycles{ 0 };
+    };
+
+    // El bloque de 0x0000 lee y escribe (HL) = 0x2000 en los ciclos 84 y 95
+    const auto mapDevice{ [](CPUTest& target, Device& device) {
+        target.memoryBus().mapIO(0x2000, 0x20FF, [](void* context, uint16_t) -> uint8_t {
+            auto* device{ static_cast<Device*>(context) };
+            device->accesses.push_back(device->cpu->getCycles());
+
+            if (device->accesses.size() == 1) {
+                device->cpu->scheduler().schedule(device->accesses.back() + 1, [](void* context, uint64_t) {
+                    auto* device{ static_cast<Device*>(context) };
+                    device->eventCycles = device->cpu->getCycles();
+                }, device);
+            }
+
+            return 0x00;
+        }, [](void* context, uint16_t, uint8_t) {
+            auto* device{ static_cast<Device*>(context) };
+            device->accesses.push_back(device->cpu->getCycles());
+        }, &device);
+    } };
+
+    Device device{ &cpu };
+    Device referenceDevice{ &reference };
+    mapDevice(cpu, device);
+    mapDevice(reference, referenceDevice);
+
+    EXPECT_EQ(cpu.run(100), reference.run(100));
+
+    const std::vector<uint64_t> expected{ 84, 95 };
+    EXPECT_EQ(device.accesses, expected);
+    EXPECT_EQ(referenceDevice.accesses, expected);
+
+    // El evento que programa la lectura corta el bloque tras el MOV A, M
+    EXPECT_EQ(device.eventCycles, 91);
+    EXPECT_EQ(referenceDevice.eventCycles, 91);
+}
+
+TEST_F(AotRunTest, ProgramMatchesROMMappedByFake8080) {
+    // Fake8080 mapea la ROM desde la imagen compartida, la memoria propia del bus no la contiene
+    Fake8080 machine{ FAKE8080_AOT_TEST_ROM };
+    ASSERT_NO_THROW(machine.cpu().setProgram(aot_test_program));
+
+    EXPECT_EQ(machine.cpu().run(1'000), cpu.run(1'000));
+
+    for (uint16_t address{ 0x2000 }; address < 0x2100; ++address) {
+        EXPECT_EQ(machine.cpu().memoryBus().read(address), rom[address]);
+    }
+}
+
+TEST_F(AotRunTest, ProgramMustMatchLoadedROM) {
+    rom[0x0001] ^= 0xFF;
+    cpu.setROM(rom);
+
+    EXPECT_THROW(cpu.setProgram(aot_test_program), std::invalid_argument);
+}
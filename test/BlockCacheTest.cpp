@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+
+class BlockCacheTest : public ::testing::Test {
+protected:
+    CPUTest cpu;
+    std::array<uint8_t, 65536> rom{};
+
+    void SetUp() override {
+        rom.fill(0);
+        cpu.setROM(rom);
+    }
+};
+
+// ==================== Tests de la traducción ====================
+
+TEST_F(BlockCacheTest, BlockEndsAtJump) {
+    rom[0] = 0x3E;  // MVI A, 0x01       7
+    rom[1] = 0x01;
+    rom[2] = 0x3C;  // INR A             5
+    rom[3] = 0xC3;  // JMP 0x0000        10
+    rom[4] = 0x00;
+    rom[5] = 0x00;
+
+    const auto& block{ cpu.translateBlock(0x0000) };
+
+    EXPECT_EQ(block.start, 0x0000);
+    EXPECT_EQ(block.end, 0x0006);
+    EXPECT_EQ(block.operations.size(), 3);
+    EXPECT_EQ(block.bodyCycles, 12);
+    EXPECT_EQ(block.operations.back().cyclesUntil, 22);
+    ASSERT_EQ(block.successorsNumber, 1);
+    EXPECT_EQ(block.successors[0], 0x0000);
+}
+
+TEST_F(BlockCacheTest, OperationsBindOperandAndLength) {
+    rom[0] = 0x01;  // LXI B, 0x1234
+    rom[1] = 0x34;
+    rom[2] = 0x12;
+    rom[3] = 0xFE;  // CPI 0x42
+    rom[4] = 0x42;
+    rom[5] = 0x76;  // HLT
+
+    const auto& block{ cpu.translateBlock(0x0000) };
+
+    ASSERT_EQ(block.operations.size(), 3);
+    EXPECT_EQ(block.operations[0].operand, 0x1234);
+    EXPECT_EQ(block.operations[0].length, 3);
+    EXPECT_EQ(block.operations[1].operand, 0x42);
+    EXPECT_EQ(block.operations[1].length, 2);
+    EXPECT_EQ(block.operations[2].length, 1);
+}
+
+TEST_F(BlockCacheTest, InterpretedBlockUsesBoundOperands) {
+    rom[0] = 0x3E;  // MVI A, 0x11       7
+    rom[1] = 0x11;
+    rom[2] = 0xC3;  // JMP 0x0000        10
+    rom[3] = 0x00;
+    rom[4] = 0x00;
+
+    cpu.run(7 + 10);
+
+    // Escribir en el buffer no pasa por el bus, el bloque ya traducido conserva sus operandos
+    rom[1] = 0x22;
+    rom[3] = 0x00;
+    rom[4] = 0x01;
+
+    cpu.run(7 + 10);
+
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x11);
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+}
+
+TEST_F(BlockCacheTest, ConditionalJumpHasTwoSuccessors) {
+    rom[0x0100] = 0xC2;  // JNZ 0x1234
+    rom[0x0101] = 0x34;
+    rom[0x0102] = 0x12;
+
+    const auto& block{ cpu.translateBlock(0x0100) };
+
+    ASSERT_EQ(block.successorsNumber, 2);
+    EXPECT_EQ(block.successors[0], 0x1234);
+    EXPECT_EQ(block.successors[1], 0x0103);
+}
+
+TEST_F(BlockCacheTest, RSTJumpsToFixedVector) {
+    rom[0x0200] = 0xCF;  // RST 1
+
+    const auto& block{ cpu.translateBlock(0x0200) };
+
+    ASSERT_EQ(block.successorsNumber, 1);
+    EXPECT_EQ(block.successors[0], 0x0008);
+}
+
+TEST_F(BlockCacheTest, StraightLineCodeIsSplitAtMaximumLength) {
+    const auto& block{ cpu.translateBlock(0x0000) };
+
+    EXPECT_EQ(block.operations.size(), BlockCache::Max_Block_Instructions);
+    EXPECT_EQ(block.end, BlockCache::Max_Block_Instructions);
+    ASSERT_EQ(block.successorsNumber, 1);
+    EXPECT_EQ(block.successors[0], BlockCache::Max_Block_Instructions);
+}
+
+TEST_F(BlockCacheTest, BlockTerminators) {
+    for (uint8_t opcode : { 0xC3, 0xC2, 0xCD, 0xC4, 0xC9, 0xC0, 0xE9, 0xC7, 0xFF, 0x76, 0xD3, 0xDB, 0xF3, 0xFB }) {
+        EXPECT_TRUE(CPUTest::Block_Terminators[opcode]) << "Opcode " << static_cast<int>(opcode);
+    }
+
+    for (uint8_t opcode : { 0x00, 0x3E, 0x77, 0x86, 0xC5, 0xE3, 0xEB, 0xF9, 0xFE }) {
+        EXPECT_FALSE(CPUTest::Block_Terminators[opcode]) << "Opcode " << static_cast<int>(opcode);
+    }
+}
+
+// ==================== Tests de la ejecución ====================
+
+TEST_F(BlockCacheTest, StaticSuccessorsAreChained) {
+    rom[0x00] = 0x06;  // MVI B, 0x00
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x04;  // INR B
+    rom[0x03] = 0xC3;  // JMP 0x0010
+    rom[0x04] = 0x10;
+    rom[0x05] = 0x00;
+
+    rom[0x10] = 0x0C;  // INR C
+    rom[0x11] = 0xC3;  // JMP 0x0002
+    rom[0x12] = 0x02;
+    rom[0x13] = 0x00;
+
+    cpu.run(1000);
+
+    const auto* loop{ cpu.blockCache_m.find(0x0002) };
+    const auto* target{ cpu.blockCache_m.find(0x0010) };
+
+    ASSERT_NE(loop, nullptr);
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(loop->links[0], target);
+    EXPECT_EQ(target->links[0], loop);
+}
+
+TEST_F(BlockCacheTest, MatchesSingleStepExecution) {
+    rom[0x00] = 0x31;  // LXI SP, 0xF000
+    rom[0x01] = 0x00;
+    rom[0x02] = 0xF0;
+    rom[0x03] = 0x21;  // LXI H, 0x2000
+    rom[0x04] = 0x00;
+    rom[0x05] = 0x20;
+    rom[0x06] = 0x7E;  // MOV A, M
+    rom[0x07] = 0x80;  // ADD B
+    rom[0x08] = 0x77;  // MOV M, A
+    rom[0x09] = 0x2C;  // INR L
+    rom[0x0A] = 0x04;  // INR B
+    rom[0x0B] = 0xCD;  // CALL 0x0020
+    rom[0x0C] = 0x20;
+    rom[0x0D] = 0x00;
+    rom[0x0E] = 0xC3;  // JMP 0x0006
+    rom[0x0F] = 0x06;
+    rom[0x10] = 0x00;
+
+    rom[0x20] = 0xC5;  // PUSH B
+    rom[0x21] = 0xEB;  // XCHG
+    rom[0x22] = 0xEB;  // XCHG
+    rom[0x23] = 0xC1;  // POP B
+    rom[0x24] = 0xC9;  // RET
+
+    std::array<uint8_t, 65536> referenceRom{ rom };
+    CPUTest reference;
+    reference.setROM(referenceRom);
+
+    for (uint64_t budget : { 1, 50, 333, 1000, 4096 }) {
+        const auto cycles{ cpu.run(budget) };
+
+        uint64_t referenceCycles{ 0 };
+        while (referenceCycles < budget) {
+            referenceCycles += reference.cycle();
+        }
+
+        EXPECT_EQ(cycles, referenceCycles);
+        EXPECT_EQ(cpu.pc_m, reference.pc_m);
+        EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::BC), reference.registers_m.getCombinedRegister(Registers::CombinedRegister::BC));
+        EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::PSW), reference.registers_m.getCombinedRegister(Registers::CombinedRegister::PSW));
+    }
+
+    EXPECT_EQ(rom, referenceRom);
+}
+
+TEST_F(BlockCacheTest, WriteInsideRunningBlockExitsIt) {
+    rom[0] = 0x3E;  // MVI A, 0x04       7
+    rom[1] = 0x04;
+    rom[2] = 0x32;  // STA 0x0006        13
+    rom[3] = 0x06;
+    rom[4] = 0x00;
+    rom[5] = 0x00;  // NOP               4
+    rom[6] = 0x00;  // NOP, se reescribe como INR B
+    rom[7] = 0xC3;  // JMP 0x0007        10
+    rom[8] = 0x07;
+    rom[9] = 0x00;
+
+    const auto cycles{ cpu.run(7 + 13 + 4 + 5 + 10) };
+
+    EXPECT_EQ(cycles, 39);
+    EXPECT_EQ(cpu.pc_m, 0x0007);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 0x01);
+    EXPECT_EQ(cpu.blockCache_m.find(0x0000), nullptr);
+}
+
+// ==================== Tests del cambio de banco ====================
+
+TEST_F(BlockCacheTest, BankSwitchDiscardsOnlyAffectedPages) {
+    std::array<uint8_t, 0x4000> bank{};
+
+    rom[0x0000] = 0xC3;  // JMP 0x4000
+    rom[0x0001] = 0x00;
+    rom[0x0002] = 0x40;
+
+    // Bloque que empieza en 0x3FFF y termina dentro del banco
+    rom[0x3FFF] = 0x00;  // NOP
+    bank[0x0000] = 0xC9; // RET
+
+    cpu.switchBank(0x4000, 0x7FFF, bank);
+    cpu.translateBlock(0x0000);
+    cpu.translateBlock(0x3FFF);
+    cpu.translateBlock(0x4000);
+
+    // Volver a mapear el mismo banco no cambia nada
+    cpu.switchBank(0x4000, 0x7FFF, bank);
+    EXPECT_NE(cpu.blockCache_m.find(0x4000), nullptr);
+
+    std::array<uint8_t, 0x4000> otherBank{};
+    cpu.switchBank(0x4000, 0x7FFF, otherBank);
+
+    EXPECT_NE(cpu.blockCache_m.find(0x0000), nullptr);
+    EXPECT_EQ(cpu.blockCache_m.find(0x3FFF), nullptr);
+    EXPECT_EQ(cpu.blockCache_m.find(0x4000), nullptr);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+
+class DecodeCacheTest : public ::testing::Test {
+protected:
+    CPUTest cpu;
+    std::array<uint8_t, 65536> rom{};
+
+    void SetUp() override {
+        rom.fill(0);
+        cpu.setROM(rom);
+    }
+};
+
+// ==================== Tests de la decodificación ====================
+
+TEST_F(DecodeCacheTest, DecodeRecordsHandlerOperandAndLength) {
+    rom[0x0100] = 0x21;  // LXI H, 0x1234
+    rom[0x0101] = 0x34;
+    rom[0x0102] = 0x12;
+
+    const auto& instruction{ cpu.decode(0x0100) };
+
+    EXPECT_TRUE(instruction.handler == CPUTest::Invokers[0x21]);
+    EXPECT_EQ(instruction.operand, 0x1234);
+    EXPECT_EQ(instruction.length, 3);
+}
+
+TEST_F(DecodeCacheTest, DecodeReadsSingleByteOperand) {
+    rom[0x0200] = 0xFE;  // CPI 0x42
+    rom[0x0201] = 0x42;
+
+    const auto& instruction{ cpu.decode(0x0200) };
+
+    EXPECT_EQ(instruction.operand, 0x42);
+    EXPECT_EQ(instruction.length, 2);
+}
+
+TEST_F(DecodeCacheTest, RunDecodesLazily) {
+    rom[0] = 0x3C;  // INR A
+
+    EXPECT_EQ(cpu.decodeCache_m.find(0x0000), nullptr);
+    EXPECT_FALSE(cpu.decodeCache_m.containsCode(0x10));
+
+    cpu.run(5);
+
+    ASSERT_NE(cpu.decodeCache_m.find(0x0000), nullptr);
+    EXPECT_EQ(cpu.decodeCache_m.find(0x0001), nullptr);
+    EXPECT_FALSE(cpu.decodeCache_m.containsCode(0x10));
+}
+
+TEST_F(DecodeCacheTest, RunUsesDecodedOperand) {
+    rom[0x00] = 0x3E;  // MVI A, 0x11
+    rom[0x01] = 0x11;
+    rom[0x02] = 0xC3;  // JMP 0x0000
+    rom[0x03] = 0x00;
+    rom[0x04] = 0x00;
+
+    // Entradas que no coinciden con la memoria, solo se pueden haber ejecutado desde la caché
+    cpu.decodeCache_m.insert(0x0000, DecodeCache::Instruction{ CPUTest::Invokers[0x3E], 0x22, 2 });
+    cpu.decodeCache_m.insert(0x0002, DecodeCache::Instruction{ CPUTest::Invokers[0xC3], 0x0100, 3 });
+
+    const auto cycles{ cpu.run(7 + 10) };
+
+    EXPECT_EQ(cycles, 17);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x22);
+    EXPECT_EQ(cpu.pc_m, 0x0100);
+}
+
+// ==================== Tests de la invalidación ====================
+
+TEST_F(DecodeCacheTest, WriteInsideInstructionInvalidatesIt) {
+    DecodeCache cache;
+    cache.insert(0x01FF, DecodeCache::Instruction{ CPUTest::Invokers[0xC3], 0x1234, 3 });
+
+    cache.invalidate(0x0202);
+    EXPECT_NE(cache.find(0x01FF), nullptr);
+
+    cache.invalidate(0x0201);
+    EXPECT_EQ(cache.find(0x01FF), nullptr);
+}
+
+TEST_F(DecodeCacheTest, InvalidatePageIncludesStraddlingInstruction) {
+    DecodeCache cache;
+    cache.insert(0x01FE, DecodeCache::Instruction{ CPUTest::Invokers[0x00], 0, 1 });
+    cache.insert(0x01FF, DecodeCache::Instruction{ CPUTest::Invokers[0x06], 0x42, 2 });
+    cache.insert(0x0200, DecodeCache::Instruction{ CPUTest::Invokers[0x00], 0, 1 });
+
+    cache.invalidatePage(0x02);
+
+    EXPECT_NE(cache.find(0x01FE), nullptr);
+    EXPECT_EQ(cache.find(0x01FF), nullptr);
+    EXPECT_EQ(cache.find(0x0200), nullptr);
+}
+
+TEST_F(DecodeCacheTest, SelfModifyingCodeExecutesNewOpcode) {
+    rom[0x00] = 0x31;  // LXI SP, 0xF000    10
+    rom[0x01] = 0x00;
+    rom[0x02] = 0xF0;
+    rom[0x03] = 0x3E;  // MVI A, 0x04       7
+    rom[0x04] = 0x04;
+    rom[0x05] = 0xCD;  // CALL 0x0010       17
+    rom[0x06] = 0x10;
+    rom[0x07] = 0x00;
+    rom[0x08] = 0x32;  // STA 0x0010        13
+    rom[0x09] = 0x10;
+    rom[0x0A] = 0x00;
+    rom[0x0B] = 0xCD;  // CALL 0x0010       17
+    rom[0x0C] = 0x10;
+    rom[0x0D] = 0x00;
+
+    rom[0x10] = 0x00;  // NOP, se reescribe como INR B
+    rom[0x11] = 0xC9;  // RET               10
+
+    const auto cycles{ cpu.run(10 + 7 + 17 + 4 + 10 + 13 + 17 + 5 + 10) };
+
+    EXPECT_EQ(cycles, 93);
+    EXPECT_EQ(cpu.pc_m, 0x000E);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 0x01);
+}
+
+TEST_F(DecodeCacheTest, WriteOverOperandExecutesNewOperand) {
+    rom[0x00] = 0x06;  // MVI B, 0x01       7
+    rom[0x01] = 0x01;
+    rom[0x02] = 0x3E;  // MVI A, 0x05       7
+    rom[0x03] = 0x05;
+    rom[0x04] = 0x32;  // STA 0x0001        13, reescribe el operando del primer MVI
+    rom[0x05] = 0x01;
+    rom[0x06] = 0x00;
+    rom[0x07] = 0xC3;  // JMP 0x0000        10
+    rom[0x08] = 0x00;
+    rom[0x09] = 0x00;
+
+    const auto cycles{ cpu.run(7 + 7 + 13 + 10 + 7) };
+
+    EXPECT_EQ(cycles, 44);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 0x05);
+}
+
+TEST_F(DecodeCacheTest, StackWriteOverCodeInvalidatesIt) {
+    rom[0x00] = 0x31;  // LXI SP, 0x0012    10
+    rom[0x01] = 0x12;
+    rom[0x02] = 0x00;
+    rom[0x03] = 0x01;  // LXI B, 0x0C0C     10
+    rom[0x04] = 0x0C;
+    rom[0x05] = 0x0C;
+    rom[0x06] = 0xC3;  // JMP 0x0010        10
+    rom[0x07] = 0x10;
+    rom[0x08] = 0x00;
+    rom[0x09] = 0xC5;  // PUSH B            11, reescribe 0x0010 y 0x0011 con INR C
+    rom[0x0A] = 0xC3;  // JMP 0x0010        10
+    rom[0x0B] = 0x10;
+    rom[0x0C] = 0x00;
+
+    rom[0x10] = 0x00;  // NOP               4
+    rom[0x11] = 0xC3;  // JMP 0x0009        10
+    rom[0x12] = 0x09;
+    rom[0x13] = 0x00;
+
+    const auto cycles{ cpu.run(10 + 10 + 10 + 4 + 10 + 11 + 10 + 5 + 5) };
+
+    EXPECT_EQ(cycles, 75);
+    EXPECT_EQ(cpu.pc_m, 0x0012);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::C), 0x0E);
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+
+class EI_DI_HLT_Test : public ::testing::Test {
+protected:
+    CPUTest cpu;
+    std::array<uint8_t, 65536> rom{};
+
+    void SetUp() override {
+        rom.fill(0);
+        cpu.setROM(rom);
+
+        // Inicializar SP en 0xF000
+        cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0xF000);
+    }
+
+    /// @brief Dirección de retorno que dejó el último RST en el stack
+    uint16_t returnAddress() const {
+        return static_cast<uint16_t>(rom[0xEFFF] << 8 | rom[0xEFFE]);
+    }
+};
+
+// ==================== Tests de DI y EI ====================
+
+TEST_F(EI_DI_HLT_Test, CyclesMatchTable) {
+    EXPECT_EQ(CPUTest::Opcodes_Cycles[0xF3], 4);
+    EXPECT_EQ(CPUTest::Opcodes_Cycles[0xFB], 4);
+    EXPECT_EQ(CPUTest::Opcodes_Cycles[0x76], 7);
+}
+
+TEST_F(EI_DI_HLT_Test, DI_ClearsInterruptEnable) {
+    cpu.interruptsEnabled_m = true;
+
+    uint8_t cycles = cpu.DI();
+
+    EXPECT_FALSE(cpu.isInterruptEnabled());
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+    EXPECT_EQ(cycles, 4);
+}
+
+TEST_F(EI_DI_HLT_Test, EI_SetsInterruptEnable) {
+    uint8_t cycles = cpu.EI();
+
+    EXPECT_TRUE(cpu.isInterruptEnabled());
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+    EXPECT_EQ(cycles, 4);
+}
+
+TEST_F(EI_DI_HLT_Test, EI_AcceptsPendingInterruptAfterNextInstruction) {
+    rom[0] = 0xFB;  // EI
+    rom[1] = 0x04;  // INR B
+    cpu.requestInterrupt(7);
+
+    // EI + INR B + RST 7
+    EXPECT_EQ(cpu.run(4 + 5 + 11), 4 + 5 + 11);
+
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 1);
+    EXPECT_EQ(cpu.pc_m, 0x0038);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
+    EXPECT_EQ(returnAddress(), 0x0002);
+    EXPECT_FALSE(cpu.isInterruptEnabled());
+}
+
+TEST_F(EI_DI_HLT_Test, DI_AfterEI_KeepsInterruptPending) {
+    rom[0] = 0xFB;  // EI
+    rom[1] = 0xF3;  // DI
+    rom[2] = 0xFB;  // EI
+    rom[3] = 0x00;  // NOP
+    cpu.requestInterrupt(1);
+
+    EXPECT_EQ(cpu.run(4 + 4), 4 + 4);
+    EXPECT_EQ(cpu.pc_m, 0x0002);
+    EXPECT_FALSE(cpu.isInterruptEnabled());
+
+    EXPECT_EQ(cpu.run(4 + 4 + 11), 4 + 4 + 11);
+    EXPECT_EQ(cpu.pc_m, 0x0008);
+    EXPECT_EQ(returnAddress(), 0x0004);
+}
+
+TEST_F(EI_DI_HLT_Test, EI_DoesNotAcceptInterruptByItself) {
+    rom[0] = 0xFB;  // EI
+    cpu.requestInterrupt(7);
+
+    EXPECT_EQ(cpu.cycle(), 4);
+
+    EXPECT_EQ(cpu.pc_m, 0x0001);
+    EXPECT_TRUE(cpu.isInterruptEnabled());
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+}
+
+TEST_F(EI_DI_HLT_Test, ConsecutiveEIsKeepInterruptBlocked) {
+    rom.fill(0xFB);     // EI en toda la memoria
+    cpu.requestInterrupt(1);
+
+    // Cada EI deja la sombra del siguiente, la solicitud sigue pendiente sin anidar llamadas
+    EXPECT_EQ(cpu.run(100), 100);
+
+    EXPECT_EQ(cpu.pc_m, 25);
+    EXPECT_TRUE(cpu.isInterruptEnabled());
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+}
+
+TEST_F(EI_DI_HLT_Test, NewRequestReplacesPendingOne) {
+    rom[0] = 0xFB;  // EI
+    cpu.requestInterrupt(2);
+    cpu.requestInterrupt(5);
+
+    // EI + NOP + RST 5
+    EXPECT_EQ(cpu.run(4 + 4 + 11), 4 + 4 + 11);
+
+    EXPECT_EQ(cpu.pc_m, 0x0028);
+}
+
+// ==================== Tests de HLT ====================
+
+TEST_F(EI_DI_HLT_Test, HLT_StaysOnInstructionWhileHalted) {
+    rom[0] = 0x76;  // HLT
+
+    EXPECT_EQ(cpu.cycle(), 7);
+    EXPECT_TRUE(cpu.isHalted());
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+
+    EXPECT_EQ(cpu.cycle(), 7);
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+}
+
+TEST_F(EI_DI_HLT_Test, HLT_WithInterruptsDisabledNeverWakes) {
+    rom[0] = 0x76;  // HLT
+    cpu.requestInterrupt(1);
+
+    EXPECT_EQ(cpu.run(70), 70);
+
+    EXPECT_TRUE(cpu.isHalted());
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+}
+
+TEST_F(EI_DI_HLT_Test, EI_HLT_ReturnsAfterHLT) {
+    rom[0] = 0xFB;  // EI
+    rom[1] = 0x76;  // HLT
+    cpu.requestInterrupt(3);
+
+    EXPECT_EQ(cpu.run(4 + 7 + 11), 4 + 7 + 11);
+
+    EXPECT_FALSE(cpu.isHalted());
+    EXPECT_EQ(cpu.pc_m, 0x0018);
+    EXPECT_EQ(returnAddress(), 0x0002);
+}
+
+// ==================== Tests de las solicitudes en run ====================
+
+TEST_F(EI_DI_HLT_Test, RequestIsIgnoredWhileDisabled) {
+    cpu.requestInterrupt(2);
+
+    EXPECT_EQ(cpu.run(20), 20);
+
+    EXPECT_EQ(cpu.pc_m, 0x0005);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+}
+
+TEST_F(EI_DI_HLT_Test, RequestIsAcceptedAtRunStartWhenEnabled) {
+    cpu.interruptsEnabled_m = true;
+    cpu.requestInterrupt(2);
+
+    EXPECT_EQ(cpu.run(11), 11);
+
+    EXPECT_EQ(cpu.pc_m, 0x0010);
+    EXPECT_EQ(returnAddress(), 0x0000);
+    EXPECT_FALSE(cpu.isInterruptEnabled());
+    EXPECT_EQ(cpu.getCycles(), 11);
+}
+
+TEST_F(EI_DI_HLT_Test, ScheduledRequestWakesHaltedCPU) {
+    rom[0] = 0x76;  // HLT
+    cpu.interruptsEnabled_m = true;
+
+    cpu.scheduler().schedule(20, [](void* context, uint64_t) {
+        static_cast<CPUTest*>(context)->requestInterrupt(1);
+    }, &cpu);
+
+    // Tres HLT llegan a 21, donde se acepta el RST 1
+    EXPECT_EQ(cpu.run(32), 32);
+
+    EXPECT_FALSE(cpu.isHalted());
+    EXPECT_EQ(cpu.pc_m, 0x0008);
+    EXPECT_EQ(returnAddress(), 0x0001);
+}
+
+TEST_F(EI_DI_HLT_Test, SetROMResetsInterruptState) {
+    cpu.interruptsEnabled_m = true;
+    cpu.halted_m = true;
+    cpu.requestInterrupt(4);
+
+    cpu.setROM(rom);
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0xF000);
+    cpu.interruptsEnabled_m = true;
+
+    EXPECT_FALSE(cpu.isHalted());
+    EXPECT_EQ(cpu.run(4), 4);
+    EXPECT_EQ(cpu.pc_m, 0x0001);
+}
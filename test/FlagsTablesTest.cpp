@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+
+class FlagsTablesTest : public ::testing::Test {
+protected:
+    CPUTest cpu;
+
+    /// @brief Referencia: la secuencia de manage*Flag que aplicaba aritmeticOperation_8bits
+    CPUTest reference;
+
+    /// @brief F inicial con CY y los bits 3 y 5 activos para comprobar que se conservan
+    static constexpr uint8_t Initial_Flags{ 0b0010'1011 };
+
+    void SetUp() override {
+        cpu.registers_m.setRegister(Registers::Register::F, Initial_Flags);
+        reference.registers_m.setRegister(Registers::Register::F, Initial_Flags);
+    }
+};
+
+// ==================== Tests de las tablas ====================
+
+TEST_F(FlagsTablesTest, SZPTableMatchesDefinition) {
+    for (uint16_t value{ 0 }; value < 256; ++value) {
+        uint8_t bits{ 0 };
+        for (uint8_t i{ 0 }; i < 8; ++i) {
+            bits += (value >> i) & 1;
+        }
+
+        EXPECT_EQ((Flags_SZP[value] & Flag_S) != 0, (value & 0x80) != 0) << "Valor " << value;
+        EXPECT_EQ((Flags_SZP[value] & Flag_Z) != 0, value == 0) << "Valor " << value;
+        EXPECT_EQ((Flags_SZP[value] & Flag_P) != 0, bits % 2 == 0) << "Valor " << value;
+        EXPECT_EQ(Flags_SZP[value] & ~(Flag_S | Flag_Z | Flag_P), 0) << "Valor " << value;
+    }
+}
+
+// ==================== Tests de las operaciones ====================
+
+TEST_F(FlagsTablesTest, ArithmeticFlagsMatchManageFunctions) {
+    for (auto op : { CPUTest::AritmeticOperation::ADD, CPUTest::AritmeticOperation::SUB }) {
+        for (bool useCarry : { false, true }) {
+            for (bool modifyCarry : { false, true }) {
+                for (uint16_t first{ 0 }; first < 256; ++first) {
+                    for (uint16_t second{ 0 }; second < 256; ++second) {
+                        SetUp();
+
+                        const auto result{ cpu.aritmeticOperation_8bits(first, second, op, useCarry, modifyCarry) };
+
+                        reference.manageAuxilaryCarryFlag(first, second, op, useCarry);
+                        if (modifyCarry) {
+                            reference.manageCarryFlag(first, second, op, useCarry);
+                        }
+                        reference.manageZeroFlag(result);
+                        reference.manageParityFlag(result);
+                        reference.manageSignedFlag(result);
+
+                        ASSERT_EQ(cpu.registers_m.getRegister(Registers::Register::F), reference.registers_m.getRegister(Registers::Register::F))
+                            << "first " << first << ", second " << second << ", op " << static_cast<int>(op)
+                            << ", useCarry " << useCarry << ", modifyCarry " << modifyCarry;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+// ==================== Tests de las condiciones ====================
+
+TEST_F(FlagsTablesTest, ConditionsTableMatchesFlags) {
+    for (uint16_t flags{ 0 }; flags < 256; ++flags) {
+        cpu.registers_m.setRegister(Registers::Register::F, static_cast<uint8_t>(flags));
+
+        const bool z{ cpu.registers_m.getFlag(Registers::Flags::Z) };
+        const bool cy{ cpu.registers_m.getFlag(Registers::Flags::CY) };
+        const bool p{ cpu.registers_m.getFlag(Registers::Flags::P) };
+        const bool s{ cpu.registers_m.getFlag(Registers::Flags::S) };
+
+        // NZ, Z, NC, C, PO, PE, P y M
+        const std::array<bool, Conditions_Number> expected{ !z, z, !cy, cy, !p, p, !s, s };
+
+        for (uint8_t condition{ 0 }; condition < Conditions_Number; ++condition) {
+            EXPECT_EQ(Conditions_Table[condition][flags], expected[condition])
+                << "F " << flags << ", condición " << static_cast<int>(condition);
+        }
+    }
+}
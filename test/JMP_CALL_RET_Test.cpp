@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+
+class JMP_CALL_RET_Test : public ::testing::Test {
+protected:
+    CPUTest cpu;
+    std::array<uint8_t, 65536> rom{};
+
+    void SetUp() override {
+        rom.fill(0);
+        cpu.setROM(rom);
+
+        // Inicializar SP en 0xF000
+        cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0xF000);
+    }
+};
+
+// ==================== Tests de NOP ====================
+
+TEST_F(JMP_CALL_RET_Test, NOP_DoesNothing) {
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::BC, 0x1234);
+
+    uint8_t cycles = cpu.NOP();
+
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::BC), 0x1234);
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+    EXPECT_EQ(cycles, 4);
+}
+
+// ==================== Tests de JMP ====================
+
+TEST_F(JMP_CALL_RET_Test, JMP_BasicJump) {
+    rom[0] = 0x34;  // Byte bajo de la dirección
+    rom[1] = 0x12;  // Byte alto de la dirección
+
+    uint8_t cycles = cpu.JMP_a16();
+
+    EXPECT_EQ(cpu.pc_m, 0x1234);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+    EXPECT_EQ(cycles, 10);
+}
+
+TEST_F(JMP_CALL_RET_Test, JMP_ToZero) {
+    cpu.pc_m = 0x0100;
+    rom[0x0100] = 0x00;
+    rom[0x0101] = 0x00;
+
+    cpu.JMP_a16();
+
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+}
+
+// ==================== Tests de CALL ====================
+
+TEST_F(JMP_CALL_RET_Test, CALL_PushesReturnAddress) {
+    cpu.pc_m = 0x0200;
+    rom[0x0200] = 0x78;
+    rom[0x0201] = 0x56;
+
+    uint8_t cycles = cpu.CALL_a16();
+
+    EXPECT_EQ(cpu.pc_m, 0x5678);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
+
+    // La dirección de retorno es la instrucción siguiente al CALL
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x02);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x02);
+    EXPECT_EQ(cycles, 17);
+}
+
+TEST_F(JMP_CALL_RET_Test, CALL_DoesNotModifyFlags) {
+    cpu.registers_m.setRegister(Registers::Register::F, 0xD7);
+    rom[0] = 0x00;
+    rom[1] = 0x30;
+
+    cpu.CALL_a16();
+
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::F), 0xD7);
+}
+
+// ==================== Tests de RET ====================
+
+TEST_F(JMP_CALL_RET_Test, RET_PopsReturnAddress) {
+    rom[0xEFFE] = 0xCD;
+    rom[0xEFFF] = 0xAB;
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0xEFFE);
+
+    uint8_t cycles = cpu.RET();
+
+    EXPECT_EQ(cpu.pc_m, 0xABCD);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+    EXPECT_EQ(cycles, 10);
+}
+
+TEST_F(JMP_CALL_RET_Test, CALL_RET_RoundTrip) {
+    cpu.pc_m = 0x0010;
+    rom[0x0010] = 0x00;
+    rom[0x0011] = 0x40;
+
+    cpu.CALL_a16();
+    cpu.RET();
+
+    EXPECT_EQ(cpu.pc_m, 0x0012);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+}
+
+// ==================== Tests de Jcc ====================
+
+TEST_F(JMP_CALL_RET_Test, Jcc_JumpsWhenConditionIsMet) {
+    cpu.registers_m.setFlag(Registers::Flags::Z, true);
+    rom[0] = 0x34;
+    rom[1] = 0x12;
+
+    // JZ
+    uint8_t cycles = cpu.Jcc_a16<1>();
+
+    EXPECT_EQ(cpu.pc_m, 0x1234);
+    EXPECT_EQ(cycles, 10);
+}
+
+TEST_F(JMP_CALL_RET_Test, Jcc_SkipsOperandWhenConditionIsNotMet) {
+    cpu.registers_m.setFlag(Registers::Flags::Z, true);
+    rom[0] = 0x34;
+    rom[1] = 0x12;
+
+    // JNZ
+    uint8_t cycles = cpu.Jcc_a16<0>();
+
+    EXPECT_EQ(cpu.pc_m, 0x0002);
+    EXPECT_EQ(cycles, 10);
+}
+
+TEST_F(JMP_CALL_RET_Test, Jcc_EvaluatesEveryCondition) {
+    // S=1, Z=0, P=1, CY=0: se cumplen NZ, NC, PE y M
+    cpu.registers_m.setRegister(Registers::Register::F, 0x86);
+
+    for (uint8_t condition{ 0 }; condition < Conditions_Number; ++condition) {
+        cpu.pc_m = 0x0000;
+        rom[0] = 0x00;
+        rom[1] = 0x30;
+
+        (cpu.*CPUTest::Opcodes[0xC2 | condition << 3])();
+
+        const bool expected{ condition == 0 || condition == 2 || condition == 5 || condition == 7 };
+        EXPECT_EQ(cpu.pc_m, expected ? 0x3000 : 0x0002) << "Condición " << static_cast<int>(condition);
+    }
+}
+
+// ==================== Tests de Ccc ====================
+
+TEST_F(JMP_CALL_RET_Test, Ccc_CallsWhenConditionIsMet) {
+    cpu.registers_m.setFlag(Registers::Flags::CY, true);
+    cpu.pc_m = 0x0200;
+    rom[0x0200] = 0x78;
+    rom[0x0201] = 0x56;
+
+    // CC
+    uint8_t cycles = cpu.Ccc_a16<3>();
+
+    EXPECT_EQ(cpu.pc_m, 0x5678);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x02);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x02);
+    EXPECT_EQ(cycles, 17);
+}
+
+TEST_F(JMP_CALL_RET_Test, Ccc_DoesNotTouchStackWhenConditionIsNotMet) {
+    cpu.pc_m = 0x0200;
+    rom[0x0200] = 0x78;
+    rom[0x0201] = 0x56;
+
+    // CC con CY = 0
+    uint8_t cycles = cpu.Ccc_a16<3>();
+
+    EXPECT_EQ(cpu.pc_m, 0x0202);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+    EXPECT_EQ(cycles, 11);
+}
+
+// ==================== Tests de Rcc ====================
+
+TEST_F(JMP_CALL_RET_Test, Rcc_ReturnsWhenConditionIsMet) {
+    rom[0xEFFE] = 0xCD;
+    rom[0xEFFF] = 0xAB;
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0xEFFE);
+
+    // RPO con P = 0
+    uint8_t cycles = cpu.Rcc<4>();
+
+    EXPECT_EQ(cpu.pc_m, 0xABCD);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+    EXPECT_EQ(cycles, 11);
+}
+
+TEST_F(JMP_CALL_RET_Test, Rcc_DoesNotTouchStackWhenConditionIsNotMet) {
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0xEFFE);
+
+    // RM con S = 0
+    uint8_t cycles = cpu.Rcc<7>();
+
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
+    EXPECT_EQ(cycles, 5);
+}
+
+// ==================== Tests de PCHL y RST ====================
+
+TEST_F(JMP_CALL_RET_Test, PCHL_CopiesHLToPC) {
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::HL, 0x4321);
+
+    uint8_t cycles = cpu.PCHL();
+
+    EXPECT_EQ(cpu.pc_m, 0x4321);
+    EXPECT_EQ(cycles, 5);
+}
+
+TEST_F(JMP_CALL_RET_Test, RST_PushesPCAndJumpsToVector) {
+    cpu.pc_m = 0x1235;
+
+    // RST 5
+    uint8_t cycles = cpu.RST_n<0x28>();
+
+    EXPECT_EQ(cpu.pc_m, 0x0028);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x12);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x35);
+    EXPECT_EQ(cycles, 11);
+}
+
+// ==================== Tests de SPHL ====================
+
+TEST_F(JMP_CALL_RET_Test, SPHL_CopiesHLToSP) {
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::HL, 0x8000);
+
+    uint8_t cycles = cpu.SPHL();
+
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0x8000);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x8000);
+    EXPECT_EQ(cycles, 5);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+#include <random>
+
+class JitTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t Code_Address{ 0x0100 };
+
+    CPUTest cpu;
+    CPUTest reference;
+    std::array<uint8_t, 65536> rom{};
+    std::array<uint8_t, 65536> referenceRom{};
+
+    std::mt19937 random{ 8080 };
+
+    void SetUp() override {
+        cpu.setROM(rom);
+        reference.setROM(referenceRom);
+    }
+
+    /// @brief Copia el estado de registros y memoria de cpu a reference
+    void synchronize() {
+        referenceRom = rom;
+        reference.registers_m = cpu.registers_m;
+        reference.pc_m = cpu.pc_m;
+    }
+
+    /// @brief Estado aleatorio, con los pares de registros lejos del código para que las escrituras no lo modifiquen
+    void randomize() {
+        for (auto& byte : rom) {
+            byte = static_cast<uint8_t>(random());
+        }
+
+        for (auto reg : { Registers::Register::A, Registers::Register::B, Registers::Register::C, Registers::Register::D,
+                          Registers::Register::E, Registers::Register::H, Registers::Register::L, Registers::Register::F }) {
+            cpu.registers_m.setRegister(reg, static_cast<uint8_t>(random()));
+        }
+
+        for (auto pair : { Registers::CombinedRegister::BC, Registers::CombinedRegister::DE, Registers::CombinedRegister::HL }) {
+            if (getHighByte(cpu.registers_m.getCombinedRegister(pair)) == getHighByte(Code_Address)) {
+                cpu.registers_m.setCombinedRegister(pair, cpu.registers_m.getCombinedRegister(pair) ^ 0x8000);
+            }
+        }
+
+        cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, static_cast<uint16_t>(random()));
+    }
+
+    void expectSameState(uint8_t opcode) {
+        for (auto pair : { Registers::CombinedRegister::BC, Registers::CombinedRegister::DE, Registers::CombinedRegister::HL,
+                           Registers::CombinedRegister::SP, Registers::CombinedRegister::PSW }) {
+            EXPECT_EQ(cpu.registers_m.getCombinedRegister(pair), reference.registers_m.getCombinedRegister(pair))
+                << "Opcode " << static_cast<int>(opcode) << ", par " << static_cast<int>(pair);
+        }
+
+        EXPECT_EQ(cpu.pc_m, reference.pc_m) << "Opcode " << static_cast<int>(opcode);
+        EXPECT_TRUE(rom == referenceRom) << "Opcode " << static_cast<int>(opcode);
+    }
+};
+
+// ==================== Tests de la traducción ====================
+
+TEST_F(JitTest, EveryCompiledOpcodeMatchesInterpreter) {
+    for (uint16_t opcode{ 0 }; opcode < CPUTest::Opcodes_Number; ++opcode) {
+        if (!JitCompiler::supports(static_cast<uint8_t>(opcode)) || CPUTest::Block_Terminators[opcode]) {
+            continue;
+        }
+
+        for (uint8_t iteration{ 0 }; iteration < 32; ++iteration) {
+            randomize();
+
+            // La instrucción seguida de un JMP a la dirección siguiente para que el bloque termine ahí
+            const auto length{ CPUTest::Opcodes_Length[opcode] };
+            const auto next{ static_cast<uint16_t>(Code_Address + length + 3) };
+
+            rom[Code_Address] = static_cast<uint8_t>(opcode);
+
+            // STA y LDA no deben apuntar a la página del código
+            if (length == 3 && rom[Code_Address + 2] == getHighByte(Code_Address)) {
+                rom[Code_Address + 2] ^= 0x80;
+            }
+
+            rom[Code_Address + length] = 0xC3;
+            rom[Code_Address + length + 1] = getLowBytes(next);
+            rom[Code_Address + length + 2] = getHighByte(next);
+
+            cpu.setROM(rom);
+            cpu.pc_m = Code_Address;
+            synchronize();
+
+            auto& block{ cpu.translateBlock(Code_Address) };
+            ASSERT_TRUE(cpu.jit_m.compile(block)) << "Opcode " << opcode;
+            ASSERT_EQ(block.nativeOperations, 2) << "Opcode " << opcode;
+
+            const auto cycles{ cpu.runNative(block) };
+            const auto referenceCycles{ reference.cycle() + reference.cycle() };
+
+            EXPECT_EQ(cycles, referenceCycles) << "Opcode " << opcode;
+            expectSameState(static_cast<uint8_t>(opcode));
+        }
+    }
+}
+
+TEST_F(JitTest, UnsupportedInstructionsStayInInterpreter) {
+    rom[0] = 0x3C;  // INR A
+    rom[1] = 0x27;  // DAA
+    rom[2] = 0x3C;  // INR A
+    rom[3] = 0xC9;  // RET
+
+    auto& block{ cpu.translateBlock(0x0000) };
+
+    ASSERT_TRUE(cpu.jit_m.compile(block));
+    EXPECT_EQ(block.nativeOperations, 1);
+
+    auto& unsupported{ cpu.translateBlock(0x0001) };
+    EXPECT_FALSE(cpu.jit_m.compile(unsupported));
+    EXPECT_EQ(unsupported.native, nullptr);
+}
+
+// ==================== Tests de la ejecución ====================
+
+TEST_F(JitTest, HotBlocksAreCompiled) {
+    rom[0x00] = 0x06;  // MVI B, 0x00
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x04;  // INR B
+    rom[0x03] = 0x80;  // ADD B
+    rom[0x04] = 0xC3;  // JMP 0x0002
+    rom[0x05] = 0x02;
+    rom[0x06] = 0x00;
+
+    synchronize();
+
+    const auto cycles{ cpu.run(100'000) };
+
+    uint64_t referenceCycles{ 0 };
+    while (referenceCycles < 100'000) {
+        referenceCycles += reference.cycle();
+    }
+
+    const auto* loop{ cpu.blockCache_m.find(0x0002) };
+    ASSERT_NE(loop, nullptr);
+    EXPECT_NE(loop->native, nullptr);
+
+    EXPECT_EQ(cycles, referenceCycles);
+    expectSameState(0x80);
+}
+
+TEST_F(JitTest, NativeBlockExitsWhenCodeIsModified) {
+    rom[0x00] = 0x31;  // LXI SP, 0xF000
+    rom[0x01] = 0x00;
+    rom[0x02] = 0xF0;
+
+    rom[0x10] = 0x04;  // INR B
+    rom[0x11] = 0x78;  // MOV A, B
+    rom[0x12] = 0x32;  // STA 0x0021, reescribe el operando del MVI del otro bloque
+    rom[0x13] = 0x21;
+    rom[0x14] = 0x00;
+    rom[0x15] = 0x0C;  // INR C
+    rom[0x16] = 0xC3;  // JMP 0x0020
+    rom[0x17] = 0x20;
+    rom[0x18] = 0x00;
+
+    rom[0x20] = 0x16;  // MVI D, xx
+    rom[0x21] = 0x00;
+    rom[0x22] = 0xC3;  // JMP 0x0010
+    rom[0x23] = 0x10;
+    rom[0x24] = 0x00;
+
+    rom[0x03] = 0xC3;  // JMP 0x0010
+    rom[0x04] = 0x10;
+    rom[0x05] = 0x00;
+
+    synchronize();
+
+    for (uint64_t budget : { 10, 500, 1'000, 3'333, 20'000 }) {
+        const auto cycles{ cpu.run(budget) };
+
+        uint64_t referenceCycles{ 0 };
+        while (referenceCycles < budget) {
+            referenceCycles += reference.cycle();
+        }
+
+        EXPECT_EQ(cycles, referenceCycles);
+        expectSameState(0x32);
+    }
+
+    const auto* writer{ cpu.blockCache_m.find(0x0010) };
+    ASSERT_NE(writer, nullptr);
+    EXPECT_NE(writer->native, nullptr);
+}
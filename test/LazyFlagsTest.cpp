@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+
+static_assert(Lazy_Flags_Enabled, "Este test se compila con FAKE8080_LAZY_FLAGS");
+
+class LazyFlagsTest : public ::testing::Test {
+protected:
+    CPUTest cpu;
+
+    /// @brief F inicial con CY y los bits 3 y 5 activos para comprobar que se conservan
+    static constexpr uint8_t Initial_Flags{ 0b0010'1011 };
+
+    void SetUp() override {
+        cpu.registers_m.setRegister(Registers::Register::F, Initial_Flags);
+    }
+};
+
+// ==================== Tests de la operación pendiente ====================
+
+TEST_F(LazyFlagsTest, IncrementKeepsCarryOfPendingOperation) {
+    // ADD deja CY pendiente, INR no lo modifica
+    cpu.aritmeticOperation_8bits(0xFF, 0x01, CPUTest::AritmeticOperation::ADD, false);
+    cpu.aritmeticOperation_8bits(0x41, 1, CPUTest::AritmeticOperation::ADD, false, false);
+
+    EXPECT_TRUE(cpu.registers_m.getFlag(Registers::Flags::CY));
+    EXPECT_FALSE(cpu.registers_m.getFlag(Registers::Flags::Z));
+    EXPECT_TRUE(cpu.registers_m.getFlag(Registers::Flags::P));
+}
+
+TEST_F(LazyFlagsTest, SetFlagAppliesOverPendingOperation) {
+    cpu.aritmeticOperation_8bits(0x00, 0x00, CPUTest::AritmeticOperation::ADD, false);
+    cpu.registers_m.setFlag(Registers::Flags::CY, true);
+
+    EXPECT_TRUE(cpu.registers_m.getFlag(Registers::Flags::Z));
+    EXPECT_TRUE(cpu.registers_m.getFlag(Registers::Flags::CY));
+}
+
+TEST_F(LazyFlagsTest, SetFlagsAppliesOverPendingOperation) {
+    // 0x0F + 0x01 deja AC pendiente, DAD solo escribe CY
+    cpu.aritmeticOperation_8bits(0x0F, 0x01, CPUTest::AritmeticOperation::ADD, false);
+    cpu.registers_m.setFlags(Flag_CY, 0);
+
+    EXPECT_TRUE(cpu.registers_m.getFlag(Registers::Flags::AC));
+    EXPECT_FALSE(cpu.registers_m.getFlag(Registers::Flags::CY));
+    EXPECT_FALSE(cpu.registers_m.getFlag(Registers::Flags::Z));
+}
+
+TEST_F(LazyFlagsTest, ReplaceFlagsDiscardsPendingOperation) {
+    cpu.aritmeticOperation_8bits(0x00, 0x00, CPUTest::AritmeticOperation::ADD, false);
+    cpu.registers_m.replaceFlags(0x80);
+
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::F), 0x82);
+}
+
+TEST_F(LazyFlagsTest, WritingFDiscardsPendingOperation) {
+    cpu.aritmeticOperation_8bits(0x00, 0x00, CPUTest::AritmeticOperation::ADD, false);
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::PSW, 0x1280);
+
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::PSW), 0x1282);
+}
+
+TEST_F(LazyFlagsTest, LogicFlagsAreResolvedOnPush) {
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0x0100);
+    cpu.registers_m.setRegister(Registers::Register::A, 0xF0);
+    cpu.registers_m.setRegister(Registers::Register::B, 0x0F);
+
+    std::array<uint8_t, 0x200> memory{};
+    cpu.setROM(memory);
+
+    cpu.ANA_R<Registers::Register::B>();
+    cpu.PUSH_RR<Registers::CombinedRegister::PSW>();
+
+    // A = 0, Z, P y AC activos, CY a 0 y los bits 3 y 5 conservados
+    EXPECT_EQ(cpu.memory_m[0x00FF], 0x00);
+    EXPECT_EQ(cpu.memory_m[0x00FE], 0b0111'1110);
+}
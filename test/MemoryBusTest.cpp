@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+#include <vector>
+
+class MemoryBusTest : public ::testing::Test {
+protected:
+    MemoryBus bus;
+};
+
+// ==================== Tests del bus ====================
+
+TEST_F(MemoryBusTest, StartsZeroedWithFullAddressSpace) {
+    EXPECT_EQ(bus.view().size(), MemoryBus::Size);
+    EXPECT_EQ(bus.read(0x0000), 0x00);
+    EXPECT_EQ(bus.read(0xFFFF), 0x00);
+
+    bus.write(0xFFFF, 0x42);
+    EXPECT_EQ(bus.read(0xFFFF), 0x42);
+}
+
+TEST_F(MemoryBusTest, LoadCopiesImageAndClearsTheRest) {
+    bus.write(0x8000, 0x55);
+
+    const std::vector<uint8_t> image{ 0x01, 0x02, 0x03 };
+    bus.load(image);
+
+    EXPECT_EQ(bus.read(0x0000), 0x01);
+    EXPECT_EQ(bus.read(0x0002), 0x03);
+    EXPECT_EQ(bus.read(0x0003), 0x00);
+    EXPECT_EQ(bus.read(0x8000), 0x00);
+}
+
+TEST_F(MemoryBusTest, LoadRejectsImagesLargerThanAddressSpace) {
+    const std::vector<uint8_t> image(MemoryBus::Size + 1);
+    EXPECT_THROW(bus.load(image), std::invalid_argument);
+}
+
+TEST_F(MemoryBusTest, AttachedBufferIsSharedWithoutCopy) {
+    std::array<uint8_t, MemoryBus::Size> memory{};
+    bus.attach(memory);
+
+    memory[0x1234] = 0xAB;
+    bus.write(0x4321, 0xCD);
+
+    EXPECT_EQ(bus.read(0x1234), 0xAB);
+    EXPECT_EQ(memory[0x4321], 0xCD);
+}
+
+// ==================== Tests de la CPU sobre el bus ====================
+
+TEST_F(MemoryBusTest, SmallROMGetsFullAddressSpace) {
+    CPUTest cpu;
+    std::array<uint8_t, 3> rom{ 0x22, 0x00, 0xF0 };  // SHLD 0xF000
+    cpu.setROM(rom);
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::HL, 0xBEEF);
+    cpu.pc_m = 0x0001;
+
+    cpu.SHLD_a16();
+
+    // Con el span anterior esta escritura quedaba fuera de la ROM
+    EXPECT_EQ(cpu.memory_m[0xF000], 0xEF);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0xBE);
+    EXPECT_EQ(rom[0], 0x22);
+}
+
+TEST_F(MemoryBusTest, WordAccessesWrapAroundAddressSpace) {
+    CPUTest cpu;
+    std::array<uint8_t, 3> rom{ 0x2A, 0xFF, 0xFF };  // LHLD 0xFFFF
+    cpu.setROM(rom);
+    cpu.memory_m[0xFFFF] = 0x34;
+    cpu.pc_m = 0x0001;
+
+    cpu.LHLD_a16();
+
+    // El byte alto se lee de 0x0000, el primer byte de la ROM
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x2A34);
+}
+
+TEST_F(MemoryBusTest, StackWrapsAroundAddressSpace) {
+    CPUTest cpu;
+    std::array<uint8_t, 1> rom{};
+    cpu.setROM(rom);
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0x0000);
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::BC, 0x1234);
+
+    cpu.PUSH_RR<Registers::CombinedRegister::BC>();
+
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xFFFE);
+    EXPECT_EQ(cpu.memory_m[0xFFFF], 0x12);
+    EXPECT_EQ(cpu.memory_m[0xFFFE], 0x34);
+}
+
+// ==================== Tests del mapa de páginas ====================
+
+struct IOProbe {
+    uint16_t lastRead{ 0 };
+    uint16_t lastWriteAddress{ 0 };
+    uint8_t lastWriteValue{ 0 };
+};
+
+static uint8_t probeRead(void* context, uint16_t address) {
+    static_cast<IOProbe*>(context)->lastRead = address;
+    return static_cast<uint8_t>(address);
+}
+
+static void probeWrite(void* context, uint16_t address, uint8_t value) {
+    auto* probe{ static_cast<IOProbe*>(context) };
+    probe->lastWriteAddress = address;
+    probe->lastWriteValue = value;
+}
+
+TEST_F(MemoryBusTest, ROMPagesDiscardWrites) {
+    bus[0x1FFF] = 0x76;
+    bus.mapROM(0x0000, 0x1FFF);
+
+    bus.write(0x1FFF, 0x00);
+    bus.write(0x2000, 0x55);
+
+    EXPECT_EQ(bus.read(0x1FFF), 0x76);
+    EXPECT_EQ(bus.read(0x2000), 0x55);
+}
+
+TEST_F(MemoryBusTest, IOPagesCallHandlers) {
+    IOProbe probe;
+    bus.mapIO(0x4000, 0x40FF, probeRead, probeWrite, &probe);
+
+    EXPECT_EQ(bus.read(0x4012), 0x12);
+    EXPECT_EQ(probe.lastRead, 0x4012);
+
+    bus.write(0x40AB, 0x99);
+    EXPECT_EQ(probe.lastWriteAddress, 0x40AB);
+    EXPECT_EQ(probe.lastWriteValue, 0x99);
+    EXPECT_EQ(bus[0x40AB], 0x00);
+
+    // La página siguiente sigue siendo RAM
+    bus.write(0x4100, 0x11);
+    EXPECT_EQ(bus.read(0x4100), 0x11);
+}
+
+TEST_F(MemoryBusTest, IOPagesWithoutHandlersAreOpenBus) {
+    bus.mapIO(0xFF00, 0xFFFF, nullptr, nullptr, nullptr);
+
+    bus.write(0xFF00, 0x12);
+
+    EXPECT_EQ(bus.read(0xFF00), MemoryBus::Open_Bus_Value);
+    EXPECT_EQ(bus[0xFF00], 0x00);
+}
+
+TEST_F(MemoryBusTest, UnmappedPagesAreOpenBus) {
+    bus.unmap(0x4000, 0x7FFF);
+
+    bus.write(0x4000, 0x12);
+
+    EXPECT_EQ(bus.read(0x4000), MemoryBus::Open_Bus_Value);
+    EXPECT_EQ(bus.peek(0x7FFF), MemoryBus::Open_Bus_Value);
+    EXPECT_FALSE(bus.isIO(0x4000));
+    EXPECT_FALSE(bus.hasIO());
+    EXPECT_FALSE(bus.hasMemory());
+
+    // Volver a mapear RAM devuelve la memoria del bus
+    bus.mapRAM(0x4000, 0x40FF);
+    bus.write(0x4000, 0x34);
+    EXPECT_EQ(bus.read(0x4000), 0x34);
+}
+
+TEST_F(MemoryBusTest, MapRejectsPartialPages) {
+    EXPECT_THROW(bus.mapROM(0x0010, 0x00FF), std::invalid_argument);
+    EXPECT_THROW(bus.mapROM(0x0000, 0x00FE), std::invalid_argument);
+    EXPECT_THROW(bus.mapRAM(0x0100, 0x00FF), std::invalid_argument);
+}
+
+TEST_F(MemoryBusTest, MapSurvivesLoadAndAttach) {
+    bus.mapROM(0x0000, 0x1FFF);
+
+    const std::array<uint8_t, 2> image{ 0xAA, 0xBB };
+    bus.load(image);
+    bus.write(0x0000, 0x00);
+    EXPECT_EQ(bus.read(0x0000), 0xAA);
+
+    std::vector<uint8_t> memory(MemoryBus::Size, 0x00);
+    memory[0x0001] = 0xCC;
+    bus.attach(std::span<uint8_t, MemoryBus::Size>{ memory.data(), MemoryBus::Size });
+    bus.write(0x0001, 0x00);
+    bus.write(0x2000, 0xDD);
+
+    EXPECT_EQ(bus.read(0x0001), 0xCC);
+    EXPECT_EQ(memory[0x2000], 0xDD);
+}
+
+TEST_F(MemoryBusTest, ArcadeMapThroughCPU) {
+    CPUTest cpu;
+    std::vector<uint8_t> rom(0x2000, 0x00);
+    rom[0x0000] = 0x77;  // MOV M,A
+    cpu.memoryBus().mapROM(0x0000, 0x1FFF);
+    cpu.setROM(rom);
+    cpu.registers_m.setRegister(Registers::Register::A, 0x3C);
+
+    // Escritura en la ROM, se descarta
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::HL, 0x0000);
+    cpu.MOV_M_R<Registers::Register::A>();
+    EXPECT_EQ(cpu.memory_m[0x0000], 0x77);
+
+    // Escritura en la RAM de vídeo
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::HL, 0x2400);
+    cpu.MOV_M_R<Registers::Register::A>();
+    EXPECT_EQ(cpu.memory_m[0x2400], 0x3C);
+
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::DE, 0x2400);
+    cpu.registers_m.setRegister(Registers::Register::A, 0x00);
+    cpu.LDAX_RR<Registers::CombinedRegister::DE>();
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x3C);
+}
+
+// ==================== Tests de bancos ====================
+
+TEST_F(MemoryBusTest, BankSwitchRemapsPagesWithoutCopying) {
+    std::vector<uint8_t> firstBank(0x4000, 0x11);
+    std::vector<uint8_t> secondBank(0x4000, 0x22);
+
+    EXPECT_TRUE(bus.mapBank(0x4000, 0x7FFF, firstBank));
+    EXPECT_EQ(bus.read(0x4000), 0x11);
+
+    bus.write(0x7FFF, 0x33);
+    EXPECT_EQ(firstBank[0x3FFF], 0x33);
+    EXPECT_EQ(bus[0x7FFF], 0x00);
+
+    EXPECT_TRUE(bus.mapBank(0x4000, 0x7FFF, secondBank));
+    EXPECT_EQ(bus.read(0x7FFF), 0x22);
+    EXPECT_FALSE(bus.mapBank(0x4000, 0x7FFF, secondBank));
+
+    // Fuera del rango se sigue usando la memoria del bus
+    bus.write(0x8000, 0x44);
+    EXPECT_EQ(bus[0x8000], 0x44);
+}
+
+TEST_F(MemoryBusTest, PeekFollowsBanksWithoutCallingHandlers) {
+    std::vector<uint8_t> bank(0x0100, 0x5A);
+    bus.mapROMBank(0x0000, 0x00FF, bank);
+
+    IOProbe probe;
+    bus.mapIO(0x4000, 0x40FF, probeRead, probeWrite, &probe);
+
+    EXPECT_EQ(bus.peek(0x0010), 0x5A);
+    EXPECT_EQ(bus.view()[0x0010], 0x00);
+
+    EXPECT_EQ(bus.peek(0x4012), MemoryBus::Open_Bus_Value);
+    EXPECT_EQ(probe.lastRead, 0x0000);
+}
+
+TEST_F(MemoryBusTest, ReadOnlyBankDiscardsWrites) {
+    std::vector<uint8_t> bank(0x0100, 0x55);
+
+    bus.mapBank(0x0000, 0x00FF, bank, false);
+    bus.write(0x0010, 0x00);
+
+    EXPECT_EQ(bus.read(0x0010), 0x55);
+    EXPECT_EQ(bank[0x0010], 0x55);
+}
+
+TEST_F(MemoryBusTest, BankMustMatchRange) {
+    std::vector<uint8_t> bank(0x2000, 0x00);
+
+    EXPECT_THROW(bus.mapBank(0x4000, 0x7FFF, bank), std::invalid_argument);
+}
+
+TEST_F(MemoryBusTest, RemappingBankedPagesRestoresBusMemory) {
+    std::vector<uint8_t> bank(0x0100, 0x66);
+    bus[0x1000] = 0x77;
+
+    bus.mapBank(0x1000, 0x10FF, bank);
+    bus.mapRAM(0x1000, 0x10FF);
+
+    EXPECT_EQ(bus.read(0x1000), 0x77);
+}
+
+// ==================== Tests de memoria compartida ====================
+
+TEST_F(MemoryBusTest, MemoryIsAllocatedOnFirstWrite) {
+    EXPECT_FALSE(bus.hasMemory());
+    EXPECT_EQ(bus.read(0x1234), 0x00);
+    EXPECT_FALSE(bus.hasMemory());
+
+    bus.write(0x1234, 0x56);
+
+    EXPECT_TRUE(bus.hasMemory());
+    EXPECT_EQ(bus.read(0x1234), 0x56);
+}
+
+TEST_F(MemoryBusTest, BankedMachineNeverAllocatesBusMemory) {
+    const std::vector<uint8_t> rom(0x2000, 0xC9);
+    std::vector<uint8_t> ram(0xE000, 0x00);
+
+    bus.mapROMBank(0x0000, 0x1FFF, rom);
+    bus.mapBank(0x2000, 0xFFFF, ram);
+
+    bus.write(0x0000, 0x00);
+    bus.write(0x2400, 0x3C);
+
+    EXPECT_EQ(bus.read(0x0000), 0xC9);
+    EXPECT_EQ(ram[0x0400], 0x3C);
+    EXPECT_FALSE(bus.hasMemory());
+}
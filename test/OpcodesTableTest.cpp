@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+
+using R = Registers::Register;
+using RR = Registers::CombinedRegister;
+
+// ==================== Tests de la decodificación DDDSSS ====================
+
+TEST(OpcodesTableTest, MOV_DecodesDestinationAndSource) {
+    EXPECT_TRUE((CPUTest::Opcodes[0x40] == CPUTest::MOV_R_R_Handler<R::B, R::B>));
+    EXPECT_TRUE((CPUTest::Opcodes[0x41] == CPUTest::MOV_R_R_Handler<R::C, R::B>));
+    EXPECT_TRUE((CPUTest::Opcodes[0x5A] == CPUTest::MOV_R_R_Handler<R::D, R::E>));
+    EXPECT_TRUE((CPUTest::Opcodes[0x6F] == CPUTest::MOV_R_R_Handler<R::A, R::L>));
+    EXPECT_TRUE((CPUTest::Opcodes[0x7C] == CPUTest::MOV_R_R_Handler<R::H, R::A>));
+}
+
+TEST(OpcodesTableTest, MOV_DecodesMemoryOperand) {
+    EXPECT_TRUE(CPUTest::Opcodes[0x46] == CPUTest::MOV_R_M_Handler<R::B>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x7E] == CPUTest::MOV_R_M_Handler<R::A>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x70] == CPUTest::MOV_M_R_Handler<R::B>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x77] == CPUTest::MOV_M_R_Handler<R::A>);
+}
+
+TEST(OpcodesTableTest, ALU_DecodesOperationAndSource) {
+    EXPECT_TRUE(CPUTest::Opcodes[0x80] == CPUTest::ADD_R_Handler<R::B>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x93] == CPUTest::SUB_R_Handler<R::E>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xAD] == CPUTest::XRA_R_Handler<R::L>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xB9] == CPUTest::CMP_R_Handler<R::C>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xBF] == CPUTest::CMP_R_Handler<R::A>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x9E] == &CPUTest::SBB_M);
+    EXPECT_TRUE(CPUTest::Opcodes[0xB6] == &CPUTest::ORA_M);
+}
+
+TEST(OpcodesTableTest, INR_DCR_MVI_DecodeDestination) {
+    EXPECT_TRUE(CPUTest::Opcodes[0x04] == CPUTest::INR_R_Handler<R::B>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x3D] == CPUTest::DCR_R_Handler<R::A>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x2E] == CPUTest::MVI_R_d8_Handler<R::L>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x34] == &CPUTest::INR_M);
+    EXPECT_TRUE(CPUTest::Opcodes[0x35] == &CPUTest::DCR_M);
+    EXPECT_TRUE(CPUTest::Opcodes[0x36] == &CPUTest::MVI_M_d8);
+}
+
+// ==================== Tests de la decodificación RP ====================
+
+TEST(OpcodesTableTest, RegisterPairOpcodes) {
+    EXPECT_TRUE(CPUTest::Opcodes[0x01] == CPUTest::LXI_RR_d16_Handler<RR::BC>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x31] == CPUTest::LXI_RR_d16_Handler<RR::SP>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x13] == CPUTest::INX_RR_Handler<RR::DE>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x39] == CPUTest::DAD_RR_Handler<RR::SP>);
+    EXPECT_TRUE(CPUTest::Opcodes[0x22] == &CPUTest::SHLD_a16);
+    EXPECT_TRUE(CPUTest::Opcodes[0x3A] == &CPUTest::LDA_a16);
+}
+
+TEST(OpcodesTableTest, PUSH_POP_UsePSWInsteadOfSP) {
+    EXPECT_TRUE(CPUTest::Opcodes[0xC5] == CPUTest::PUSH_RR_Handler<RR::BC>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xE5] == CPUTest::PUSH_RR_Handler<RR::HL>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xF5] == CPUTest::PUSH_RR_Handler<RR::PSW>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xD1] == CPUTest::POP_RR_Handler<RR::DE>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xF1] == CPUTest::POP_RR_Handler<RR::PSW>);
+}
+
+// ==================== Tests de opcodes especiales ====================
+
+TEST(OpcodesTableTest, UndocumentedAliases) {
+    for (uint8_t opcode : { 0x00, 0x08, 0x10, 0x18, 0x20, 0x28, 0x30, 0x38 }) {
+        EXPECT_TRUE(CPUTest::Opcodes[opcode] == &CPUTest::NOP) << "Opcode " << static_cast<int>(opcode);
+    }
+
+    EXPECT_TRUE(CPUTest::Opcodes[0xCB] == &CPUTest::JMP_a16);
+    EXPECT_TRUE(CPUTest::Opcodes[0xD9] == &CPUTest::RET);
+
+    for (uint8_t opcode : { 0xCD, 0xDD, 0xED, 0xFD }) {
+        EXPECT_TRUE(CPUTest::Opcodes[opcode] == &CPUTest::CALL_a16) << "Opcode " << static_cast<int>(opcode);
+    }
+}
+
+TEST(OpcodesTableTest, ImmediateAndAccumulatorOpcodes) {
+    EXPECT_TRUE(CPUTest::Opcodes[0xC6] == &CPUTest::ADI_d8);
+    EXPECT_TRUE(CPUTest::Opcodes[0xDE] == &CPUTest::SCI_d8);
+    EXPECT_TRUE(CPUTest::Opcodes[0xFE] == &CPUTest::CPI_d8);
+    EXPECT_TRUE(CPUTest::Opcodes[0xE3] == &CPUTest::XTHL);
+    EXPECT_TRUE(CPUTest::Opcodes[0xF9] == &CPUTest::SPHL);
+    EXPECT_TRUE(CPUTest::Opcodes[0x27] == &CPUTest::DAA);
+    EXPECT_TRUE(CPUTest::Opcodes[0x3F] == &CPUTest::CMC);
+}
+
+TEST(OpcodesTableTest, ConditionalOpcodesDecodeCondition) {
+    EXPECT_TRUE(CPUTest::Opcodes[0xC2] == CPUTest::Jcc_a16_Handler<0>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xCA] == CPUTest::Jcc_a16_Handler<1>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xFA] == CPUTest::Jcc_a16_Handler<7>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xD4] == CPUTest::Ccc_a16_Handler<2>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xEC] == CPUTest::Ccc_a16_Handler<5>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xD8] == CPUTest::Rcc_Handler<3>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xF0] == CPUTest::Rcc_Handler<6>);
+    EXPECT_TRUE(CPUTest::Opcodes[0xE9] == &CPUTest::PCHL);
+}
+
+TEST(OpcodesTableTest, RSTDecodesVector) {
+    for (uint8_t vector{ 0 }; vector < 8; ++vector) {
+        const uint8_t opcode = 0xC7 | vector << 3;
+        EXPECT_EQ(CPUTest::Opcodes[opcode], (std::array{ CPUTest::RST_n_Handler<0x00>, CPUTest::RST_n_Handler<0x08>,
+                                                         CPUTest::RST_n_Handler<0x10>, CPUTest::RST_n_Handler<0x18>,
+                                                         CPUTest::RST_n_Handler<0x20>, CPUTest::RST_n_Handler<0x28>,
+                                                         CPUTest::RST_n_Handler<0x30>, CPUTest::RST_n_Handler<0x38> })[vector]);
+    }
+}
+
+// ==================== Tests de longitudes y ciclos ====================
+
+TEST(OpcodesTableTest, InstructionLengths) {
+    EXPECT_EQ(CPUTest::Opcodes_Length[0x00], 1);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0x01], 3);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0x06], 2);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0x0A], 1);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0x22], 3);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0x3A], 3);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0x36], 2);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0x7E], 1);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xC2], 3);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xC3], 3);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xCD], 3);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xDD], 3);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xD3], 2);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xDB], 2);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xE3], 1);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xFE], 2);
+    EXPECT_EQ(CPUTest::Opcodes_Length[0xFF], 1);
+}
+
+TEST(OpcodesTableTest, CyclesMatchHandlers) {
+    std::array<uint8_t, 65536> rom{};
+
+    for (size_t opcode{ 0 }; opcode < CPUTest::Opcodes_Number; ++opcode) {
+        if (CPUTest::Opcodes[opcode] == &CPUTest::InvalidOpcode) {
+            EXPECT_EQ(CPUTest::Opcodes_Cycles[opcode], 0) << "Opcode " << opcode;
+            continue;
+        }
+
+        CPUTest cpu;
+        rom.fill(0);
+        cpu.setROM(rom);
+        cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0xF000);
+
+        // La tabla guarda el coste de Ccc y Rcc sin salto, con F = 0x02 se cumplen NZ, NC, PO y P
+        auto expected{ CPUTest::Opcodes_Cycles[opcode] };
+        const bool taken{ Conditions_Table[(opcode >> 3) & 0b111][cpu.registers_m.getRegister(Registers::Register::F)] };
+
+        if ((opcode & 0b11000111) == 0b11000100 && taken) {
+            expected += Ccc_a16_Taken_Extra_Cycles;
+        }
+        else if ((opcode & 0b11000111) == 0b11000000 && taken) {
+            expected += Rcc_Taken_Extra_Cycles;
+        }
+
+        EXPECT_EQ((cpu.*CPUTest::Opcodes[opcode])(), expected) << "Opcode " << opcode;
+    }
+}
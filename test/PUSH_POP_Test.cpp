@@ -49,8 +49,8 @@ TEST_F(PUSH_POP_Test, PUSH_BC_BasicOperation) {
     
     // Verificar que los datos se almacenaron en el stack (little endian en memoria de stack)
     // High byte (0x12) se almacena primero, luego low byte (0x34)
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x12);  // High byte en SP+1
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0x34);  // Low byte en SP
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x12);  // High byte en SP+1
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x34);  // Low byte en SP
     
     EXPECT_EQ(cycles, 11);
 }
@@ -61,8 +61,8 @@ TEST_F(PUSH_POP_Test, PUSH_BC_ZeroValue) {
     uint8_t cycles = cpu.PUSH_RR<Registers::CombinedRegister::BC>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x00);
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0x00);
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x00);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x00);
     EXPECT_EQ(cycles, 11);
 }
 
@@ -72,8 +72,8 @@ TEST_F(PUSH_POP_Test, PUSH_BC_MaxValue) {
     uint8_t cycles = cpu.PUSH_RR<Registers::CombinedRegister::BC>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0xFF);
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0xFF);
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0xFF);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0xFF);
     EXPECT_EQ(cycles, 11);
 }
 
@@ -85,8 +85,8 @@ TEST_F(PUSH_POP_Test, PUSH_DE_BasicOperation) {
     uint8_t cycles = cpu.PUSH_RR<Registers::CombinedRegister::DE>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x56);
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0x78);
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x56);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x78);
     EXPECT_EQ(cycles, 11);
 }
 
@@ -98,8 +98,8 @@ TEST_F(PUSH_POP_Test, PUSH_HL_BasicOperation) {
     uint8_t cycles = cpu.PUSH_RR<Registers::CombinedRegister::HL>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0xAB);
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0xCD);
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0xAB);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0xCD);
     EXPECT_EQ(cycles, 11);
 }
 
@@ -113,8 +113,8 @@ TEST_F(PUSH_POP_Test, PUSH_PSW_BasicOperation) {
     uint8_t cycles = cpu.PUSH_RR<Registers::CombinedRegister::PSW>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x42);  // A (high byte)
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0xD7);  // F (low byte)
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x42);  // A (high byte)
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0xD7);  // F (low byte)
     EXPECT_EQ(cycles, 11);
 }
 
@@ -130,9 +130,9 @@ TEST_F(PUSH_POP_Test, PUSH_PSW_WithFlags) {
     uint8_t cycles = cpu.PUSH_RR<Registers::CombinedRegister::PSW>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0xAB);  // Acumulador
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0xAB);  // Acumulador
     // Flags: S=1, Z=1, AC=0, P=1, CY=1, bit1=1 -> 0xC7
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0xC7);  // Flags
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0xC7);  // Flags
     EXPECT_EQ(cycles, 11);
 }
 
@@ -142,8 +142,8 @@ TEST_F(PUSH_POP_Test, PUSH_PSW_ZeroValue) {
     uint8_t cycles = cpu.PUSH_RR<Registers::CombinedRegister::PSW>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFE);
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x00);
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0x02);  // F con bit 1 forzado a 1
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x00);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x02);  // F con bit 1 forzado a 1
     EXPECT_EQ(cycles, 11);
 }
 
@@ -372,12 +372,12 @@ TEST_F(PUSH_POP_Test, MultiplePUSH_StackGrowsDown) {
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFA);
     
     // Verificar datos en stack
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x11);  // BC high
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0x11);  // BC low
-    EXPECT_EQ(cpu.rom_m[0xEFFD], 0x22);  // DE high
-    EXPECT_EQ(cpu.rom_m[0xEFFC], 0x22);  // DE low
-    EXPECT_EQ(cpu.rom_m[0xEFFB], 0x33);  // HL high
-    EXPECT_EQ(cpu.rom_m[0xEFFA], 0x33);  // HL low
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x11);  // BC high
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x11);  // BC low
+    EXPECT_EQ(cpu.memory_m[0xEFFD], 0x22);  // DE high
+    EXPECT_EQ(cpu.memory_m[0xEFFC], 0x22);  // DE low
+    EXPECT_EQ(cpu.memory_m[0xEFFB], 0x33);  // HL high
+    EXPECT_EQ(cpu.memory_m[0xEFFA], 0x33);  // HL low
 }
 
 TEST_F(PUSH_POP_Test, MultiplePUSH_IncludingPSW) {
@@ -393,12 +393,12 @@ TEST_F(PUSH_POP_Test, MultiplePUSH_IncludingPSW) {
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xEFFA);
     
     // Verificar datos en stack
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x11);  // BC high
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0x11);  // BC low
-    EXPECT_EQ(cpu.rom_m[0xEFFD], 0x22);  // HL high
-    EXPECT_EQ(cpu.rom_m[0xEFFC], 0x22);  // HL low
-    EXPECT_EQ(cpu.rom_m[0xEFFB], 0x33);  // A
-    EXPECT_EQ(cpu.rom_m[0xEFFA], 0x46);  // F (flags con bit 1=1)
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x11);  // BC high
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x11);  // BC low
+    EXPECT_EQ(cpu.memory_m[0xEFFD], 0x22);  // HL high
+    EXPECT_EQ(cpu.memory_m[0xEFFC], 0x22);  // HL low
+    EXPECT_EQ(cpu.memory_m[0xEFFB], 0x33);  // A
+    EXPECT_EQ(cpu.memory_m[0xEFFA], 0x46);  // F (flags con bit 1=1)
 }
 
 TEST_F(PUSH_POP_Test, MultiplePOP_LIFO_Order) {
@@ -603,8 +603,8 @@ TEST_F(PUSH_POP_Test, EdgeCase_PUSHAtLowMemory) {
     cpu.PUSH_RR<Registers::CombinedRegister::BC>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0x000E);
-    EXPECT_EQ(cpu.rom_m[0x000F], 0xAA);
-    EXPECT_EQ(cpu.rom_m[0x000E], 0xAA);
+    EXPECT_EQ(cpu.memory_m[0x000F], 0xAA);
+    EXPECT_EQ(cpu.memory_m[0x000E], 0xAA);
 }
 
 TEST_F(PUSH_POP_Test, EdgeCase_StackNearBoundary) {
@@ -618,8 +618,8 @@ TEST_F(PUSH_POP_Test, EdgeCase_StackNearBoundary) {
     cpu.PUSH_RR<Registers::CombinedRegister::BC>();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0x0000);
-    EXPECT_EQ(cpu.rom_m[0x0001], 0xBB);
-    EXPECT_EQ(cpu.rom_m[0x0000], 0xBB);
+    EXPECT_EQ(cpu.memory_m[0x0001], 0xBB);
+    EXPECT_EQ(cpu.memory_m[0x0000], 0xBB);
 }
 
 TEST_F(PUSH_POP_Test, EdgeCase_DeepStack) {
@@ -693,9 +693,9 @@ TEST_F(PUSH_POP_Test, ByteOrder_VerifyStackLayout) {
     
     // Verificar orden de bytes en memoria
     // BC: 0x12AB -> [0xEFFF]=0x12, [0xEFFE]=0xAB
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x12);
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0xAB);
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x12);
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0xAB);
     // DE: 0x34CD -> [0xEFFD]=0x34, [0xEFFC]=0xCD
-    EXPECT_EQ(cpu.rom_m[0xEFFD], 0x34);
-    EXPECT_EQ(cpu.rom_m[0xEFFC], 0xCD);
+    EXPECT_EQ(cpu.memory_m[0xEFFD], 0x34);
+    EXPECT_EQ(cpu.memory_m[0xEFFC], 0xCD);
 }
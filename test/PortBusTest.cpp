@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+
+/// @brief Dispositivo de prueba: un latch que devuelve lo último escrito más el puerto
+struct LatchDevice {
+    uint8_t value{ 0 };
+    uint8_t writes{ 0 };
+
+    uint8_t read(uint8_t port) {
+        return static_cast<uint8_t>(value + port);
+    }
+
+    void write(uint8_t, uint8_t newValue) {
+        value = newValue;
+        ++writes;
+    }
+};
+
+class PortBusTest : public ::testing::Test {
+protected:
+    PortBus bus;
+    LatchDevice device;
+};
+
+// ==================== Tests del bus ====================
+
+TEST_F(PortBusTest, UnboundPortsReadOpenBus) {
+    EXPECT_EQ(bus.read(0x00), PortBus::Default_Open_Bus_Value);
+    EXPECT_EQ(bus.read(0xFF), PortBus::Default_Open_Bus_Value);
+
+    bus.write(0x10, 0x42);
+
+    bus.setOpenBusValue(0x00);
+    EXPECT_EQ(bus.read(0x10), 0x00);
+}
+
+TEST_F(PortBusTest, FunctionHandlersReceiveContextAndPort) {
+    bus.bindInput(0x01, [](void* context, uint8_t port) -> uint8_t {
+        return static_cast<uint8_t>(*static_cast<uint8_t*>(context) ^ port);
+    }, &device.value);
+    device.value = 0xF0;
+
+    EXPECT_EQ(bus.read(0x01), 0xF1);
+    EXPECT_EQ(bus.read(0x02), PortBus::Default_Open_Bus_Value);
+}
+
+TEST_F(PortBusTest, MethodHandlersAreBoundToDevice) {
+    bus.bindInput<&LatchDevice::read>(0x03, device);
+    bus.bindOutput<&LatchDevice::write>(0x04, device);
+
+    bus.write(0x04, 0x20);
+    bus.write(0x05, 0x30);
+
+    EXPECT_EQ(device.writes, 1);
+    EXPECT_EQ(bus.read(0x03), 0x23);
+}
+
+TEST_F(PortBusTest, UnbindRestoresOpenBus) {
+    bus.bindInput<&LatchDevice::read>(0x03, device);
+    bus.bindOutput<&LatchDevice::write>(0x03, device);
+
+    bus.unbindInput(0x03);
+    bus.unbindOutput(0x03);
+    bus.write(0x03, 0x55);
+
+    EXPECT_EQ(bus.read(0x03), PortBus::Default_Open_Bus_Value);
+    EXPECT_EQ(device.writes, 0);
+}
+
+// ==================== Tests de IN y OUT ====================
+
+class IN_OUT_Test : public ::testing::Test {
+protected:
+    CPUTest cpu;
+    std::array<uint8_t, 65536> rom{};
+    LatchDevice device;
+
+    void SetUp() override {
+        rom.fill(0);
+        cpu.setROM(rom);
+        cpu.portBus().bindInput<&LatchDevice::read>(0x10, device);
+        cpu.portBus().bindOutput<&LatchDevice::write>(0x10, device);
+    }
+};
+
+TEST_F(IN_OUT_Test, OUT_WritesAccumulatorToPort) {
+    rom[0x0001] = 0x10;
+    cpu.pc_m = 0x0001;
+    cpu.registers_m.setRegister(Registers::Register::A, 0x5A);
+    cpu.registers_m.setRegister(Registers::Register::F, 0xD7);
+
+    const auto cycles{ cpu.OUT_d8() };
+
+    EXPECT_EQ(cycles, 10);
+    EXPECT_EQ(cpu.pc_m, 0x0002);
+    EXPECT_EQ(device.value, 0x5A);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::F), 0xD7);
+}
+
+TEST_F(IN_OUT_Test, IN_ReadsPortIntoAccumulator) {
+    rom[0x0001] = 0x10;
+    cpu.pc_m = 0x0001;
+    device.value = 0x30;
+    cpu.registers_m.setRegister(Registers::Register::F, 0x02);
+
+    const auto cycles{ cpu.IN_d8() };
+
+    EXPECT_EQ(cycles, 10);
+    EXPECT_EQ(cpu.pc_m, 0x0002);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x40);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::F), 0x02);
+}
+
+TEST_F(IN_OUT_Test, IN_FromUnboundPortReadsOpenBus) {
+    rom[0x0001] = 0x20;
+    cpu.pc_m = 0x0001;
+    cpu.portBus().setOpenBusValue(0x00);
+    cpu.registers_m.setRegister(Registers::Register::A, 0x99);
+
+    cpu.IN_d8();
+
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x00);
+}
+
+TEST_F(IN_OUT_Test, OpcodesDecodeToPortHandlers) {
+    EXPECT_EQ(CPUTest::Opcodes[0xD3], &CPUTest::OUT_d8);
+    EXPECT_EQ(CPUTest::Opcodes[0xDB], &CPUTest::IN_d8);
+    EXPECT_EQ(CPUTest::Opcodes_Cycles[0xD3], 10);
+    EXPECT_EQ(CPUTest::Opcodes_Cycles[0xDB], 10);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "Registers.hpp"
+#include <tuple>
 
 class RegistersTest : public ::testing::Test {
 protected:
@@ -307,6 +308,26 @@ TEST_F(RegistersTest, ClearingFlagDoesNotAffectOtherFlags) {
     EXPECT_TRUE(registers.getFlag(Registers::Flags::CY));
 }
 
+TEST_F(RegistersTest, SetFlagsUpdatesOnlyMaskedFlags) {
+    registers.setRegister(Registers::Register::F, 0b1000'0011);
+
+    // Z y CY cambian en una sola escritura, S y los bits fuera de la máscara se conservan
+    registers.setFlags(Flag_Z | Flag_CY, Flag_Z | Flag_AC);
+
+    EXPECT_EQ(registers.getRegister(Registers::Register::F), 0b1100'0010);
+}
+
+TEST_F(RegistersTest, SetFlagsKeepsBitOne) {
+    registers.setFlags(0xFF, 0x00);
+    EXPECT_EQ(registers.getRegister(Registers::Register::F), 0x02);
+}
+
+TEST_F(RegistersTest, ReplaceFlagsKeepsBitOne) {
+    registers.replaceFlags(0xD5);
+    EXPECT_EQ(registers.getRegister(Registers::Register::F), 0xD7);
+    EXPECT_EQ(registers.getCombinedRegister(Registers::CombinedRegister::PSW) & 0xFF, 0xD7);
+}
+
 // Tests para el registro PSW (Program Status Word)
 TEST_F(RegistersTest, SetAndGetCombinedRegisterPSW) {
     registers.setCombinedRegister(Registers::CombinedRegister::PSW, 0x12D7);
@@ -410,3 +431,41 @@ TEST_F(RegistersTest, PSWChangingFlagsUpdatesLowByte) {
     EXPECT_EQ(registers.getCombinedRegister(Registers::CombinedRegister::PSW), 0x42D7);
 }
 
+
+// Tests de evaluación en tiempo de compilación
+TEST_F(RegistersTest, RegistersAreUsableInConstantExpressions) {
+    constexpr auto hl{ [] {
+        Registers constant;
+        constant.setRegister(Registers::Register::H, 0x12);
+        constant.setRegister(Registers::Register::L, 0x34);
+        return constant.getCombinedRegister(Registers::CombinedRegister::HL);
+    }() };
+
+    constexpr auto flags{ [] {
+        Registers constant;
+        constant.setCombinedRegister(Registers::CombinedRegister::PSW, 0xAB00);
+        constant.setFlag(Registers::Flags::CY, true);
+        return constant.getRegister(Registers::Register::F);
+    }() };
+
+    static_assert(hl == 0x1234);
+    static_assert(flags == 0x03);
+
+    EXPECT_EQ(hl, 0x1234);
+    EXPECT_EQ(flags, 0x03);
+}
+
+TEST_F(RegistersTest, PairWritesMatchByteWrites) {
+    for (auto [pair, high, low] : { std::tuple{ Registers::CombinedRegister::BC, Registers::Register::B, Registers::Register::C },
+                                    std::tuple{ Registers::CombinedRegister::DE, Registers::Register::D, Registers::Register::E },
+                                    std::tuple{ Registers::CombinedRegister::HL, Registers::Register::H, Registers::Register::L },
+                                    std::tuple{ Registers::CombinedRegister::SP, Registers::Register::SP_high, Registers::Register::SP_low },
+                                    std::tuple{ Registers::CombinedRegister::WZ, Registers::Register::W, Registers::Register::Z } }) {
+        registers.setCombinedRegister(pair, 0xBEEF);
+        EXPECT_EQ(registers.getRegister(high), 0xBE);
+        EXPECT_EQ(registers.getRegister(low), 0xEF);
+
+        registers.setRegister(low, 0x01);
+        EXPECT_EQ(registers.getCombinedRegister(pair), 0xBE01);
+    }
+}
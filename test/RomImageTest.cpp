@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "RomImage.hpp"
+#include "AotProgram.hpp"
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+class RomImageTest : public ::testing::Test {
+protected:
+    std::filesystem::path path;
+
+    void SetUp() override {
+        const auto* test{ ::testing::UnitTest::GetInstance()->current_test_info() };
+        path = std::filesystem::temp_directory_path() / (std::string{ "fake8080_" } + test->name() + ".rom");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    void writeFile(const std::vector<uint8_t>& contents) const {
+        std::ofstream file{ path, std::ios::binary };
+        file.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+    }
+};
+
+// ==================== Tests de la carga ====================
+
+TEST_F(RomImageTest, RegularFileIsMapped) {
+    const std::vector<uint8_t> contents{ 0xC3, 0x00, 0x00, 0x76 };
+    writeFile(contents);
+
+    const auto image{ RomImage::open(path.string()) };
+
+    EXPECT_TRUE(image->isMapped());
+    ASSERT_EQ(image->data().size(), contents.size());
+    EXPECT_TRUE(std::equal(contents.begin(), contents.end(), image->data().begin()));
+}
+
+TEST_F(RomImageTest, SamePathSharesImage) {
+    writeFile({ 0x00, 0x01 });
+
+    const auto first{ RomImage::open(path.string()) };
+    const auto second{ RomImage::open(path.string()) };
+
+    EXPECT_EQ(first.get(), second.get());
+}
+
+TEST_F(RomImageTest, SameContentsFromAnotherPathShareImage) {
+    const std::vector<uint8_t> contents{ 0x31, 0x00, 0x24, 0xC3, 0x00, 0x00 };
+    writeFile(contents);
+
+    const auto copy{ std::filesystem::path{ path }.replace_extension(".copy.rom") };
+    std::filesystem::copy_file(path, copy, std::filesystem::copy_options::overwrite_existing);
+
+    const auto first{ RomImage::open(path.string()) };
+    const auto second{ RomImage::open(copy.string()) };
+    std::filesystem::remove(copy);
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(first->hash(), AotProgram::hash(contents));
+}
+
+TEST_F(RomImageTest, ImageIsReleasedWithLastInstance) {
+    writeFile({ 0x00 });
+
+    std::weak_ptr<const RomImage> released;
+    {
+        const auto image{ RomImage::open(path.string()) };
+        released = image;
+    }
+
+    EXPECT_TRUE(released.expired());
+}
+
+TEST_F(RomImageTest, EmptyFileIsEmptyImage) {
+    writeFile({});
+
+    const auto image{ RomImage::open(path.string()) };
+
+    EXPECT_TRUE(image->data().empty());
+}
+
+TEST_F(RomImageTest, MissingFileThrows) {
+    EXPECT_THROW(static_cast<void>(RomImage::open(path.string())), std::runtime_error);
+}
+
+#if defined(__linux__)
+TEST_F(RomImageTest, PipeIsReadByBlocks) {
+    std::array<int, 2> descriptors{};
+    ASSERT_EQ(pipe(descriptors.data()), 0);
+
+    const std::array<uint8_t, 3> contents{ 0x3E, 0x42, 0x76 };
+    ASSERT_EQ(write(descriptors[1], contents.data(), contents.size()), static_cast<ssize_t>(contents.size()));
+    close(descriptors[1]);
+
+    const auto image{ RomImage::open("/proc/self/fd/" + std::to_string(descriptors[0])) };
+    close(descriptors[0]);
+
+    EXPECT_FALSE(image->isMapped());
+    ASSERT_EQ(image->data().size(), contents.size());
+    EXPECT_TRUE(std::equal(contents.begin(), contents.end(), image->data().begin()));
+}
+#endif
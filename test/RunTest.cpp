@@ -0,0 +1,535 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+#include <vector>
+
+class RunTest : public ::testing::Test {
+protected:
+    CPUTest cpu;
+    std::array<uint8_t, 65536> rom{};
+
+    void SetUp() override {
+        rom.fill(0);
+        cpu.setROM(rom);
+    }
+};
+
+// ==================== Tests del presupuesto de ciclos ====================
+
+TEST_F(RunTest, ZeroBudgetExecutesNothing) {
+    const auto cycles{ cpu.run(0) };
+
+    EXPECT_EQ(cycles, 0);
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+}
+
+TEST_F(RunTest, ExactBudgetStopsOnInstructionBoundary) {
+    // 3 NOPs de 4 ciclos cada uno
+    const auto cycles{ cpu.run(12) };
+
+    EXPECT_EQ(cycles, 12);
+    EXPECT_EQ(cpu.pc_m, 0x0003);
+}
+
+TEST_F(RunTest, LastInstructionMayExceedBudget) {
+    rom[0] = 0x06;  // MVI B, 0x42 (7 ciclos)
+    rom[1] = 0x42;
+    rom[2] = 0x0E;  // MVI C, 0x24 (7 ciclos)
+    rom[3] = 0x24;
+
+    const auto cycles{ cpu.run(8) };
+
+    EXPECT_EQ(cycles, 14);
+    EXPECT_EQ(cpu.pc_m, 0x0004);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 0x42);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::C), 0x24);
+}
+
+TEST_F(RunTest, ConsecutiveRunsContinueFromPC) {
+    rom[0] = 0x3E;  // MVI A, 0x01
+    rom[1] = 0x01;
+    rom[2] = 0x3C;  // INR A
+    rom[3] = 0x3C;  // INR A
+
+    EXPECT_EQ(cpu.run(7), 7);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x01);
+
+    EXPECT_EQ(cpu.run(10), 10);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x03);
+}
+
+TEST_F(RunTest, CycleExecutesSingleInstruction) {
+    rom[0] = 0x21;  // LXI H, 0x1234
+    rom[1] = 0x34;
+    rom[2] = 0x12;
+
+    EXPECT_EQ(cpu.cycle(), 10);
+    EXPECT_EQ(cpu.pc_m, 0x0003);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x1234);
+}
+
+// ==================== Tests de programas ====================
+
+TEST_F(RunTest, ArithmeticProgram) {
+    rom[0] = 0x3E;  // MVI A, 0x10       7
+    rom[1] = 0x10;
+    rom[2] = 0x06;  // MVI B, 0x22       7
+    rom[3] = 0x22;
+    rom[4] = 0x80;  // ADD B             4
+    rom[5] = 0x32;  // STA 0x2000        13
+    rom[6] = 0x00;
+    rom[7] = 0x20;
+    rom[8] = 0xC3;  // JMP 0x0008        10
+    rom[9] = 0x08;
+    rom[10] = 0x00;
+
+    const auto cycles{ cpu.run(31) };
+
+    EXPECT_EQ(cycles, 31);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x32);
+    EXPECT_EQ(rom[0x2000], 0x32);
+
+    // El bucle infinito solo consume ciclos
+    EXPECT_EQ(cpu.run(100), 100);
+    EXPECT_EQ(cpu.pc_m, 0x0008);
+}
+
+TEST_F(RunTest, SubroutineProgram) {
+    rom[0] = 0x31;  // LXI SP, 0xF000    10
+    rom[1] = 0x00;
+    rom[2] = 0xF0;
+    rom[3] = 0xCD;  // CALL 0x0010       17
+    rom[4] = 0x10;
+    rom[5] = 0x00;
+    rom[6] = 0x04;  // INR B             5
+
+    rom[0x10] = 0x0E;  // MVI C, 0x55    7
+    rom[0x11] = 0x55;
+    rom[0x12] = 0xC9;  // RET            10
+
+    const auto cycles{ cpu.run(49) };
+
+    EXPECT_EQ(cycles, 49);
+    EXPECT_EQ(cpu.pc_m, 0x0007);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 0x01);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::C), 0x55);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+}
+
+TEST_F(RunTest, ConditionalControlFlowProgram) {
+    rom[0x00] = 0x31;  // LXI SP, 0xF000    10
+    rom[0x01] = 0x00;
+    rom[0x02] = 0xF0;
+    rom[0x03] = 0x06;  // MVI B, 0x03       7
+    rom[0x04] = 0x03;
+    rom[0x05] = 0x05;  // DCR B             5
+    rom[0x06] = 0xC4;  // CNZ 0x0020        17 / 11
+    rom[0x07] = 0x20;
+    rom[0x08] = 0x00;
+    rom[0x09] = 0xC2;  // JNZ 0x0005        10
+    rom[0x0A] = 0x05;
+    rom[0x0B] = 0x00;
+    rom[0x0C] = 0xE7;  // RST 4             11
+    rom[0x0D] = 0x21;  // LXI H, 0x0040     10
+    rom[0x0E] = 0x40;
+    rom[0x0F] = 0x00;
+    rom[0x10] = 0xE9;  // PCHL              5
+
+    rom[0x20] = 0x0C;  // INR C             5
+    rom[0x21] = 0xC0;  // RNZ               11 / 5
+
+    // Dos vueltas con llamada (48 ciclos cada una), la última sin llamada ni salto (26),
+    // RST 4 con su subrutina (27) y LXI H y PCHL (15)
+    const auto cycles{ cpu.run(181) };
+
+    EXPECT_EQ(cycles, 181);
+    EXPECT_EQ(cpu.pc_m, 0x0040);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 0x00);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::C), 0x03);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+}
+
+TEST_F(RunTest, AccumulatorAndFlagsProgram) {
+    rom[0] = 0x31;  // LXI SP, 0xF000    10
+    rom[1] = 0x00;
+    rom[2] = 0xF0;
+    rom[3] = 0x06;  // MVI B, 0x7F       7
+    rom[4] = 0x7F;
+    rom[5] = 0x78;  // MOV A, B          5
+    rom[6] = 0x3C;  // INR A             5
+    rom[7] = 0x4F;  // MOV C, A          5
+    rom[8] = 0xF5;  // PUSH PSW          11
+    rom[9] = 0xD1;  // POP D             10
+
+    const auto cycles{ cpu.run(53) };
+
+    EXPECT_EQ(cycles, 53);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x80);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::C), 0x80);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::D), 0x80);
+
+    // S=1, Z=0, AC=1, P=0, CY=0 y el bit 1 fijo
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::E), 0x92);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::F), 0x92);
+}
+
+// ==================== Tests de cambio de banco ====================
+
+TEST_F(RunTest, BankSwitchExecutesNewBankCode) {
+    std::vector<uint8_t> firstBank(0x4000, 0x00);
+    std::vector<uint8_t> secondBank(0x4000, 0x00);
+
+    rom[0] = 0xC3;  // JMP 0x4000        10
+    rom[1] = 0x00;
+    rom[2] = 0x40;
+
+    firstBank[0] = 0x3C;  // INR A       5
+    firstBank[1] = 0xC3;  // JMP 0x0000  10
+    firstBank[2] = 0x00;
+    firstBank[3] = 0x00;
+
+    secondBank[0] = 0x04;  // INR B      5
+    secondBank[1] = 0xC3;  // JMP 0x0000 10
+    secondBank[2] = 0x00;
+    secondBank[3] = 0x00;
+
+    cpu.switchBank(0x4000, 0x7FFF, firstBank);
+    EXPECT_EQ(cpu.run(25), 25);
+
+    cpu.switchBank(0x4000, 0x7FFF, secondBank);
+    EXPECT_EQ(cpu.run(25), 25);
+
+    cpu.switchBank(0x4000, 0x7FFF, firstBank);
+    EXPECT_EQ(cpu.run(25), 25);
+
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x02);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 0x01);
+}
+
+TEST_F(RunTest, BankSwitchThroughOutputPort) {
+    struct BankSelector {
+        CPUTest* cpu;
+        std::array<std::vector<uint8_t>, 2> banks;
+
+        void select(uint8_t, uint8_t value) {
+            cpu->switchBank(0x8000, 0xFFFF, banks[value & 1]);
+        }
+    };
+
+    BankSelector selector{ &cpu, { std::vector<uint8_t>(0x8000, 0x00), std::vector<uint8_t>(0x8000, 0x00) } };
+    cpu.portBus().bindOutput<&BankSelector::select>(0x01, selector);
+
+    rom[0] = 0xAF;  // XRA A             4
+    rom[1] = 0xD3;  // OUT 0x01          10
+    rom[2] = 0x01;
+    rom[3] = 0xCD;  // CALL 0x8000       17
+    rom[4] = 0x00;
+    rom[5] = 0x80;
+    rom[6] = 0x3E;  // MVI A, 0x01       7
+    rom[7] = 0x01;
+    rom[8] = 0xD3;  // OUT 0x01          10
+    rom[9] = 0x01;
+    rom[10] = 0xCD; // CALL 0x8000       17
+    rom[11] = 0x00;
+    rom[12] = 0x80;
+
+    selector.banks[0][0] = 0x04;  // INR B     5
+    selector.banks[0][1] = 0xC9;  // RET       10
+    selector.banks[1][0] = 0x0C;  // INR C     5
+    selector.banks[1][1] = 0xC9;  // RET       10
+
+    cpu.registers_m.setCombinedRegister(Registers::CombinedRegister::SP, 0x7000);
+
+    const auto cycles{ cpu.run(4 + 10 + 17 + 15 + 7 + 10 + 17 + 15) };
+
+    EXPECT_EQ(cycles, 95);
+    EXPECT_EQ(cpu.pc_m, 0x000D);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 0x01);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::C), 0x01);
+}
+
+// ==================== Tests del planificador ====================
+
+TEST_F(RunTest, ScheduledEventsSeeInstructionBoundaries) {
+    rom[0] = 0x04;  // INR B             5
+    rom[1] = 0x0C;  // INR C             5
+    rom[2] = 0xC3;  // JMP 0x0000        10
+    rom[3] = 0x00;
+    rom[4] = 0x00;
+
+    struct Probe {
+        CPUTest* cpu;
+        std::vector<std::pair<uint64_t, uint8_t>> samples;
+    };
+
+    Probe probe{ &cpu, {} };
+    const auto sample{ [](void* context, uint64_t) {
+        auto* probe{ static_cast<Probe*>(context) };
+        probe->samples.emplace_back(probe->cpu->getCycles(), probe->cpu->registers_m.getRegister(Registers::Register::C));
+    } };
+
+    cpu.scheduler().schedule(7, sample, &probe);
+    cpu.scheduler().schedule(45, sample, &probe);
+
+    // Tres vueltas de 20 ciclos: 7 se atiende en 10, tras el primer INR C, y 45 en 45, tras el INR B de la tercera vuelta
+    EXPECT_EQ(cpu.run(60), 60);
+
+    const std::vector<std::pair<uint64_t, uint8_t>> expected{ { 10, 1 }, { 45, 2 } };
+    EXPECT_EQ(probe.samples, expected);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 3);
+}
+
+TEST_F(RunTest, PortHandlersSeeCyclesInsideSlice) {
+    // 10 NOP de 4 ciclos y OUT 0x05 en el ciclo 40, después NOP hasta el final del presupuesto
+    rom[10] = 0xD3;
+    rom[11] = 0x05;
+
+    struct Device {
+        CPUTest* cpu;
+        uint64_t outputCycles{ 0 };
+        uint64_t eventCycles{ 0 };
+
+        void write(uint8_t, uint8_t) {
+            outputCycles = cpu->getCycles();
+            cpu->scheduler().schedule(outputCycles + 8, [](void* context, uint64_t) {
+                auto* device{ static_cast<Device*>(context) };
+                device->eventCycles = device->cpu->getCycles();
+            }, this);
+        }
+    };
+
+    Device device{ &cpu };
+    cpu.portBus().bindOutput<&Device::write>(0x05, device);
+
+    // El evento en 48 corta la porción y se atiende en 50, tras el OUT, no al final de los 1002 ciclos
+    EXPECT_EQ(cpu.run(1002), 1002);
+    EXPECT_EQ(device.outputCycles, 40);
+    EXPECT_EQ(device.eventCycles, 50);
+}
+
+TEST_F(RunTest, IOPageHandlersSeeCyclesInsideBlock) {
+    // 10 NOP de 4 ciclos, después LXI H y MOV M, A en el ciclo 50, en mitad de un bloque que sigue con NOP
+    rom[10] = 0x21;  // LXI H, 0x8000    10
+    rom[11] = 0x00;
+    rom[12] = 0x80;
+    rom[13] = 0x77;  // MOV M, A         7
+    rom[14] = 0x04;  // INR B            5
+
+    struct Device {
+        CPUTest* cpu;
+        uint64_t writeCycles{ 0 };
+        uint64_t eventCycles{ 0 };
+        uint8_t eventB{ 0xFF };
+    };
+
+    Device device{ &cpu };
+    cpu.memoryBus().mapIO(0x8000, 0x80FF, nullptr, [](void* context, uint16_t, uint8_t) {
+        auto* device{ static_cast<Device*>(context) };
+        device->writeCycles = device->cpu->getCycles();
+        device->cpu->scheduler().schedule(device->writeCycles + 4, [](void* context, uint64_t) {
+            auto* device{ static_cast<Device*>(context) };
+            device->eventCycles = device->cpu->getCycles();
+            device->eventB = device->cpu->registers_m.getRegister(Registers::Register::B);
+        }, device);
+    }, &device);
+
+    // El evento en 54 corta la porción en 57, tras el MOV y antes del INR B
+    EXPECT_EQ(cpu.run(1002), 1002);
+    EXPECT_EQ(device.writeCycles, 50);
+    EXPECT_EQ(device.eventCycles, 57);
+    EXPECT_EQ(device.eventB, 0);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 1);
+}
+
+TEST_F(RunTest, PeriodicInterruptsWakeHaltedCPU) {
+    rom[0x00] = 0x31;  // LXI SP, 0xF000
+    rom[0x01] = 0x00;
+    rom[0x02] = 0xF0;
+    rom[0x03] = 0xFB;  // EI
+    rom[0x04] = 0x76;  // HLT
+    rom[0x05] = 0xC3;  // JMP 0x0003
+    rom[0x06] = 0x03;
+    rom[0x07] = 0x00;
+    rom[0x08] = 0x04;  // RST 1: INR B
+    rom[0x09] = 0xC9;  // RET
+
+    struct Timer {
+        CPUTest* cpu;
+        Scheduler::EventId id;
+    };
+
+    Timer timer{ &cpu, 0 };
+    timer.id = cpu.scheduler().schedule(100, [](void* context, uint64_t deadline) {
+        auto* timer{ static_cast<Timer*>(context) };
+        timer->cpu->requestInterrupt(1);
+        timer->cpu->scheduler().reschedule(timer->id, deadline + 100);
+    }, &timer);
+
+    cpu.run(350);
+
+    // Cada interrupción se atiende con la CPU detenida y vuelve al bucle tras el HLT
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::B), 3);
+    EXPECT_TRUE(cpu.isHalted());
+    EXPECT_EQ(cpu.pc_m, 0x0004);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
+}
+
+// ==================== Tests de los bucles de espera ====================
+
+TEST_F(RunTest, InterruptAtEIBoundaryWaitsForNextInstruction) {
+    rom[0x00] = 0x31;  // LXI SP, 0x1000  10
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x10;
+    rom[0x03] = 0xFB;  // EI              4
+    rom[0x04] = 0x3E;  // MVI A, 0x55     7
+    rom[0x05] = 0x55;
+    rom[0x06] = 0x76;  // HLT
+
+    // La solicitud llega justo cuando termina EI, en el ciclo 14
+    cpu.scheduler().schedule(14, [](void* context, uint64_t) {
+        static_cast<CPUTest*>(context)->requestInterrupt(1);
+    }, &cpu);
+
+    // LXI + EI + MVI + RST 1
+    EXPECT_EQ(cpu.run(10 + 4 + 7 + 11), 10 + 4 + 7 + 11);
+
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 0x55);
+    EXPECT_EQ(cpu.pc_m, 0x0008);
+    EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0x0FFE);
+    EXPECT_EQ(rom[0x0FFE], 0x06);
+    EXPECT_EQ(rom[0x0FFF], 0x00);
+}
+
+TEST_F(RunTest, HaltStopsSliceEarly) {
+    rom[0] = 0x76;  // HLT
+
+    EXPECT_EQ(cpu.runSlice(1000), 7);
+    EXPECT_EQ(cpu.idleCycles_m, 7);
+}
+
+TEST_F(RunTest, HaltFastForwardKeepsEventBoundaries) {
+    rom[0] = 0x76;  // HLT
+
+    struct Probe {
+        CPUTest* cpu;
+        std::vector<uint64_t> samples;
+    };
+
+    Probe probe{ &cpu, {} };
+    cpu.scheduler().schedule(100, [](void* context, uint64_t) {
+        auto* probe{ static_cast<Probe*>(context) };
+        probe->samples.push_back(probe->cpu->getCycles());
+    }, &probe);
+
+    // Igual que ejecutando un HLT cada 7 ciclos: el evento ve la frontera 105 y el presupuesto acaba en 203
+    EXPECT_EQ(cpu.run(200), 203);
+
+    const std::vector<uint64_t> expected{ 105 };
+    EXPECT_EQ(probe.samples, expected);
+    EXPECT_TRUE(cpu.isHalted());
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+}
+
+TEST_F(RunTest, PollingLoopStopsSliceEarly) {
+    rom[0x00] = 0x3A;  // LDA 0x2000         13
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x20;
+    rom[0x03] = 0xA7;  // ANA A              4
+    rom[0x04] = 0xCA;  // JZ 0x0000          10
+    rom[0x05] = 0x00;
+    rom[0x06] = 0x00;
+
+    // La primera vuelta arma el bucle y la segunda confirma que deja A y F igual
+    EXPECT_EQ(cpu.runSlice(1000), 54);
+    EXPECT_EQ(cpu.idleCycles_m, 27);
+    EXPECT_EQ(cpu.pc_m, 0x0000);
+}
+
+TEST_F(RunTest, JumpToItselfIsIdle) {
+    rom[0x00] = 0xC3;  // JMP 0x0000
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x00;
+
+    EXPECT_EQ(cpu.runSlice(1000), 20);
+    EXPECT_EQ(cpu.idleCycles_m, 10);
+    EXPECT_EQ(cpu.run(1000), 1000);
+}
+
+TEST_F(RunTest, PollingLoopSeesEventsAtSameBoundary) {
+    rom[0x00] = 0x3A;  // LDA 0x2000         13
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x20;
+    rom[0x03] = 0xA7;  // ANA A              4
+    rom[0x04] = 0xCA;  // JZ 0x0000          10
+    rom[0x05] = 0x00;
+    rom[0x06] = 0x00;
+    rom[0x07] = 0x76;  // HLT
+
+    struct Probe {
+        CPUTest* cpu;
+        std::array<uint8_t, 65536>* memory;
+        uint64_t cycles;
+    };
+
+    Probe probe{ &cpu, &rom, 0 };
+    cpu.scheduler().schedule(1000, [](void* context, uint64_t) {
+        auto* probe{ static_cast<Probe*>(context) };
+        probe->cycles = probe->cpu->getCycles();
+        (*probe->memory)[0x2000] = 1;
+    }, &probe);
+
+    cpu.run(1100);
+
+    // 37 vueltas llegan a 999 y el evento se atiende tras el LDA siguiente, que todavía ha leído 0. La vuelta
+    // posterior lee 1 y sale al HLT
+    EXPECT_EQ(probe.cycles, 1012);
+    EXPECT_TRUE(cpu.isHalted());
+    EXPECT_EQ(cpu.pc_m, 0x0007);
+    EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), 1);
+}
+
+TEST_F(RunTest, LoopWithSideEffectsIsNotIdle) {
+    rom[0x00] = 0x3A;  // LDA 0x2000
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x20;
+    rom[0x03] = 0x32;  // STA 0x2001
+    rom[0x04] = 0x01;
+    rom[0x05] = 0x20;
+    rom[0x06] = 0xC3;  // JMP 0x0000
+    rom[0x07] = 0x00;
+    rom[0x08] = 0x00;
+
+    EXPECT_GE(cpu.runSlice(1000), 1000);
+    EXPECT_EQ(cpu.idleCycles_m, 0);
+}
+
+TEST_F(RunTest, LoopChangingStateIsNotIdle) {
+    rom[0x00] = 0x3C;  // INR A
+    rom[0x01] = 0xC3;  // JMP 0x0000
+    rom[0x02] = 0x00;
+    rom[0x03] = 0x00;
+
+    EXPECT_GE(cpu.runSlice(1000), 1000);
+    EXPECT_EQ(cpu.idleCycles_m, 0);
+}
+
+TEST_F(RunTest, PollingIOPageIsNotIdle) {
+    rom[0x00] = 0x3A;  // LDA 0x2000         13
+    rom[0x01] = 0x00;
+    rom[0x02] = 0x20;
+    rom[0x03] = 0xA7;  // ANA A              4
+    rom[0x04] = 0xCA;  // JZ 0x0000          10
+    rom[0x05] = 0x00;
+    rom[0x06] = 0x00;
+
+    uint32_t reads{ 0 };
+    cpu.memoryBus().mapIO(0x2000, 0x20FF, [](void* context, uint16_t) -> uint8_t {
+        ++*static_cast<uint32_t*>(context);
+        return 0;
+    }, nullptr, &reads);
+
+    // Cada lectura del dispositivo puede tener efectos, así que se hacen todas
+    EXPECT_EQ(cpu.run(270), 270);
+    EXPECT_EQ(reads, 10);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "commons/CPUTest.hpp"
+#include <utility>
 
 class STC_CMA_CMC_DAA_Test : public ::testing::Test {
 protected:
@@ -381,6 +382,55 @@ TEST_F(STC_CMA_CMC_DAA_Test, DAA_DoesNotModifyOtherRegisters) {
     EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::C), 0x34);
 }
 
+/// @brief Implementación de DAA anterior a la tabla, con ramas por nibble y las flags una a una
+static std::pair<uint8_t, uint8_t> referenceDAA(uint8_t accumulator, uint8_t flags) {
+    const bool auxCarry = getBit(flags, 4);
+    bool carry = getBit(flags, 0);
+
+    if (auxCarry || (accumulator & 0x0F) > 9) {
+        accumulator += 0x06;
+    }
+
+    if (carry || (accumulator >> 4) > 9) {
+        accumulator += 0x60;
+        carry = true;
+    }
+
+    uint8_t bits{ 0 };
+    for (uint8_t i{ 0 }; i < 8; ++i) {
+        bits += (accumulator >> i) & 1;
+    }
+
+    flags = setBit(flags, 0, carry);
+    flags = setBit(flags, 6, accumulator == 0);
+    flags = setBit(flags, 2, bits % 2 == 0);
+    flags = setBit(flags, 7, (accumulator >> 7) == 1);
+
+    return { accumulator, flags };
+}
+
+TEST_F(STC_CMA_CMC_DAA_Test, DAA_TableMatchesReferenceForAllInputs) {
+    for (uint16_t accumulator{ 0 }; accumulator < 256; ++accumulator) {
+        for (bool auxCarry : { false, true }) {
+            for (bool carry : { false, true }) {
+                // Los bits 3 y 5 deben conservarse
+                const uint8_t flags = 0b0010'1010 | (auxCarry << 4) | carry;
+
+                cpu.registers_m.setRegister(Registers::Register::A, static_cast<uint8_t>(accumulator));
+                cpu.registers_m.setRegister(Registers::Register::F, flags);
+                cpu.DAA();
+
+                const auto [expectedA, expectedF] = referenceDAA(static_cast<uint8_t>(accumulator), flags);
+
+                EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::A), expectedA)
+                    << "A " << accumulator << ", AC " << auxCarry << ", CY " << carry;
+                EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::F), expectedF)
+                    << "A " << accumulator << ", AC " << auxCarry << ", CY " << carry;
+            }
+        }
+    }
+}
+
 // ==================== Tests combinados ====================
 
 TEST_F(STC_CMA_CMC_DAA_Test, Combined_STC_Then_CMC) {
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include "commons/CPUTest.hpp"
+#include <array>
+#include <vector>
+
+/// @brief Registro de los eventos disparados: (marca, plazo)
+struct EventLog {
+    std::vector<std::pair<int, uint64_t>> fired;
+};
+
+template<int Mark>
+static void logEvent(void* context, uint64_t deadline) {
+    static_cast<EventLog*>(context)->fired.emplace_back(Mark, deadline);
+}
+
+class SchedulerTest : public ::testing::Test {
+protected:
+    Scheduler scheduler;
+    EventLog log;
+};
+
+// ==================== Tests del planificador ====================
+
+TEST_F(SchedulerTest, EmptySchedulerHasNoDeadline) {
+    EXPECT_EQ(scheduler.nextDeadline(), Scheduler::No_Deadline);
+    EXPECT_EQ(scheduler.runDue(1'000'000), 0);
+}
+
+TEST_F(SchedulerTest, EventsFireInDeadlineOrder) {
+    scheduler.schedule(300, logEvent<3>, &log);
+    scheduler.schedule(100, logEvent<1>, &log);
+    scheduler.schedule(200, logEvent<2>, &log);
+
+    EXPECT_EQ(scheduler.nextDeadline(), 100);
+    EXPECT_EQ(scheduler.runDue(250), 2);
+    EXPECT_EQ(scheduler.nextDeadline(), 300);
+
+    const std::vector<std::pair<int, uint64_t>> expected{ { 1, 100 }, { 2, 200 } };
+    EXPECT_EQ(log.fired, expected);
+}
+
+TEST_F(SchedulerTest, SameDeadlineFiresInScheduleOrder) {
+    for (int i{ 0 }; i < 8; ++i) {
+        scheduler.schedule(50, i % 2 == 0 ? logEvent<0> : logEvent<1>, &log);
+    }
+
+    scheduler.runDue(50);
+
+    ASSERT_EQ(log.fired.size(), 8);
+    for (size_t i{ 0 }; i < log.fired.size(); ++i) {
+        EXPECT_EQ(log.fired[i].first, static_cast<int>(i % 2));
+    }
+}
+
+TEST_F(SchedulerTest, CancelRemovesPendingEvent) {
+    const auto first{ scheduler.schedule(100, logEvent<1>, &log) };
+    scheduler.schedule(200, logEvent<2>, &log);
+
+    EXPECT_TRUE(scheduler.cancel(first));
+    EXPECT_FALSE(scheduler.cancel(first));
+    EXPECT_FALSE(scheduler.isPending(first));
+
+    scheduler.runDue(1000);
+
+    const std::vector<std::pair<int, uint64_t>> expected{ { 2, 200 } };
+    EXPECT_EQ(log.fired, expected);
+}
+
+TEST_F(SchedulerTest, RescheduleMovesEvent) {
+    const auto first{ scheduler.schedule(100, logEvent<1>, &log) };
+    scheduler.schedule(200, logEvent<2>, &log);
+
+    EXPECT_TRUE(scheduler.reschedule(first, 300));
+    EXPECT_EQ(scheduler.nextDeadline(), 200);
+
+    scheduler.runDue(1000);
+
+    const std::vector<std::pair<int, uint64_t>> expected{ { 2, 200 }, { 1, 300 } };
+    EXPECT_EQ(log.fired, expected);
+}
+
+TEST_F(SchedulerTest, RescheduleRejectsStaleId) {
+    const auto fired{ scheduler.schedule(10, logEvent<1>, &log) };
+    scheduler.runDue(10);
+
+    const auto cancelled{ scheduler.schedule(50, logEvent<2>, &log) };
+    scheduler.cancel(cancelled);
+
+    EXPECT_FALSE(scheduler.reschedule(fired, 20));
+    EXPECT_FALSE(scheduler.reschedule(cancelled, 60));
+    EXPECT_FALSE(scheduler.reschedule(1000, 70));
+
+    // El identificador se recicla sin que quede otra entrada suya en el montículo
+    const auto recycled{ scheduler.schedule(30, logEvent<3>, &log) };
+    EXPECT_TRUE(scheduler.cancel(recycled));
+    EXPECT_EQ(scheduler.nextDeadline(), Scheduler::No_Deadline);
+
+    scheduler.runDue(1000);
+
+    const std::vector<std::pair<int, uint64_t>> expected{ { 1, 10 } };
+    EXPECT_EQ(log.fired, expected);
+}
+
+TEST_F(SchedulerTest, PeriodicEventReschedulesItself) {
+    struct Timer {
+        Scheduler* scheduler;
+        Scheduler::EventId id;
+        std::vector<uint64_t> ticks;
+    };
+
+    Timer timer{ &scheduler, 0, {} };
+    timer.id = scheduler.schedule(100, [](void* context, uint64_t deadline) {
+        auto* timer{ static_cast<Timer*>(context) };
+        timer->ticks.push_back(deadline);
+        timer->scheduler->reschedule(timer->id, deadline + 100);
+    }, &timer);
+
+    scheduler.runDue(350);
+
+    const std::vector<uint64_t> expected{ 100, 200, 300 };
+    EXPECT_EQ(timer.ticks, expected);
+    EXPECT_TRUE(scheduler.isPending(timer.id));
+    EXPECT_EQ(scheduler.nextDeadline(), 400);
+}
+
+TEST_F(SchedulerTest, FiredEventsAreRecycled) {
+    const auto first{ scheduler.schedule(10, logEvent<1>, &log) };
+    scheduler.runDue(10);
+
+    const auto second{ scheduler.schedule(20, logEvent<2>, &log) };
+
+    EXPECT_EQ(first, second);
+    EXPECT_TRUE(scheduler.isPending(second));
+}
+
+TEST_F(SchedulerTest, ManyEventsStayOrdered) {
+    std::vector<uint64_t> fired;
+    std::vector<Scheduler::EventId> ids;
+
+    for (uint64_t i{ 0 }; i < 200; ++i) {
+        ids.push_back(scheduler.schedule((i * 7919) % 1000, [](void* context, uint64_t deadline) {
+            static_cast<std::vector<uint64_t>*>(context)->push_back(deadline);
+        }, &fired));
+    }
+
+    for (size_t i{ 0 }; i < ids.size(); i += 3) {
+        scheduler.cancel(ids[i]);
+    }
+
+    scheduler.runDue(1000);
+
+    EXPECT_EQ(fired.size(), 200 - 67);
+    EXPECT_TRUE(std::is_sorted(fired.begin(), fired.end()));
+}
+
+// ==================== Tests de la integración con la CPU ====================
+
+TEST_F(SchedulerTest, EventsInsideSliceShortenIt) {
+    uint64_t budget{ 100 };
+    scheduler.beginSlice(1000, &budget);
+
+    scheduler.schedule(1200, logEvent<1>, &log);
+    EXPECT_EQ(budget, 100);
+
+    const auto id{ scheduler.schedule(1060, logEvent<2>, &log) };
+    EXPECT_EQ(budget, 60);
+
+    scheduler.reschedule(id, 1020);
+    EXPECT_EQ(budget, 20);
+
+    // Un plazo ya pasado termina la porción en la instrucción en curso
+    scheduler.schedule(900, logEvent<3>, &log);
+    EXPECT_EQ(budget, 0);
+
+    scheduler.endSlice();
+    budget = 100;
+    scheduler.schedule(1010, logEvent<4>, &log);
+    EXPECT_EQ(budget, 100);
+}
+
+TEST_F(SchedulerTest, RunStopsAtDeadlines) {
+    CPUTest cpu;
+    std::array<uint8_t, 65536> rom{};
+    cpu.setROM(rom);
+
+    struct Probe {
+        CPUTest* cpu;
+        std::vector<uint64_t> cycles;
+    };
+
+    Probe probe{ &cpu, {} };
+    const auto record{ [](void* context, uint64_t) {
+        auto* probe{ static_cast<Probe*>(context) };
+        probe->cycles.push_back(probe->cpu->getCycles());
+    } };
+
+    // NOPs de 4 ciclos: el evento de 10 se atiende en la frontera de 12
+    cpu.scheduler().schedule(10, record, &probe);
+    cpu.scheduler().schedule(40, record, &probe);
+    cpu.scheduler().schedule(1000, record, &probe);
+
+    EXPECT_EQ(cpu.run(40), 40);
+    EXPECT_EQ(cpu.getCycles(), 40);
+
+    const std::vector<uint64_t> expected{ 12, 40 };
+    EXPECT_EQ(probe.cycles, expected);
+    EXPECT_EQ(cpu.scheduler().nextDeadline(), 1000);
+}
@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include "SpaceInvadersMachine.hpp"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class SpaceInvadersMachineTest : public ::testing::Test {
+protected:
+    static constexpr size_t Rom_Size{ 0x800 };
+
+    /// @brief Las cuatro ROMs seguidas, 0x0000-0x1FFF
+    std::vector<uint8_t> program;
+
+    std::array<std::filesystem::path, 4> paths;
+    std::array<std::string, 4> pathStrings;
+    std::array<std::string_view, 4> pathViews;
+
+    void SetUp() override {
+        program.assign(4 * Rom_Size, 0);
+
+        const auto* test{ ::testing::UnitTest::GetInstance()->current_test_info() };
+
+        for (size_t i{ 0 }; i < paths.size(); ++i) {
+            paths[i] = std::filesystem::temp_directory_path() / (std::string{ "fake8080_" } + test->name() + "_" + std::string{ SpaceInvadersMachine::Rom_Names[i] });
+            pathStrings[i] = paths[i].string();
+            pathViews[i] = pathStrings[i];
+        }
+    }
+
+    void TearDown() override {
+        for (const auto& path : paths) {
+            std::filesystem::remove(path);
+        }
+    }
+
+    /// @brief Reparte el programa entre los cuatro ficheros de ROM
+    void writeRoms(size_t romSize = Rom_Size) const {
+        for (size_t i{ 0 }; i < paths.size(); ++i) {
+            std::ofstream file{ paths[i], std::ios::binary };
+            file.write(reinterpret_cast<const char*>(program.data() + i * Rom_Size), static_cast<std::streamsize>(romSize));
+        }
+    }
+};
+
+// ==================== Tests del mapa de memoria ====================
+
+TEST_F(SpaceInvadersMachineTest, RomsAreMappedInOrder) {
+    for (size_t i{ 0 }; i < 4; ++i) {
+        program[i * Rom_Size] = static_cast<uint8_t>(0xA0 + i);
+    }
+    writeRoms();
+
+    SpaceInvadersMachine machine{ pathViews };
+    auto& bus{ machine.cpu().memoryBus() };
+
+    EXPECT_EQ(bus.read(0x0000), 0xA0);
+    EXPECT_EQ(bus.read(0x0800), 0xA1);
+    EXPECT_EQ(bus.read(0x1000), 0xA2);
+    EXPECT_EQ(bus.read(0x1800), 0xA3);
+    EXPECT_EQ(machine.ramStart(), SpaceInvadersMachine::RAM_Start);
+}
+
+TEST_F(SpaceInvadersMachineTest, RomIsReadOnlyAndVideoRamIsVisible) {
+    program[0x00] = 0x3E;  // MVI A, 0x5A
+    program[0x01] = 0x5A;
+    program[0x02] = 0x32;  // STA 0x0100
+    program[0x03] = 0x00;
+    program[0x04] = 0x01;
+    program[0x05] = 0x32;  // STA 0x2400
+    program[0x06] = 0x00;
+    program[0x07] = 0x24;
+    program[0x08] = 0x76;  // HLT
+    writeRoms();
+
+    SpaceInvadersMachine machine{ pathViews };
+    machine.runFrame();
+
+    EXPECT_EQ(machine.cpu().memoryBus().read(0x0100), 0x00);
+    ASSERT_EQ(machine.videoRAM().size(), SpaceInvadersMachine::Video_RAM_Size);
+    EXPECT_EQ(machine.videoRAM()[0], 0x5A);
+}
+
+TEST_F(SpaceInvadersMachineTest, OnlyBoardRamIsConnected) {
+    writeRoms();
+
+    SpaceInvadersMachine machine{ pathViews };
+    auto& bus{ machine.cpu().memoryBus() };
+
+    EXPECT_EQ(machine.ram().size(), 0x2000);
+
+    bus.write(0x3FFF, 0x12);
+    bus.write(0x4000, 0x34);
+    bus.write(0xFFFF, 0x56);
+
+    EXPECT_EQ(bus.read(0x3FFF), 0x12);
+    EXPECT_EQ(bus.read(0x4000), MemoryBus::Open_Bus_Value);
+    EXPECT_EQ(bus.read(0xFFFF), MemoryBus::Open_Bus_Value);
+    EXPECT_FALSE(bus.hasMemory());
+}
+
+TEST_F(SpaceInvadersMachineTest, RomTailOutsideRamIsReadOnly) {
+    program[0x77F] = 0xC9;
+    writeRoms(0x780);
+
+    const std::array<Fake8080::RamRange, 1> ranges{ { { 0x2000, 0x3FFF } } };
+    Fake8080 machine{ std::span<const std::string_view>{ pathViews }.first(1), ranges };
+    auto& bus{ machine.cpu().memoryBus() };
+
+    bus.write(0x077F, 0x00);
+    bus.write(0x0780, 0x00);
+
+    EXPECT_EQ(machine.romSize(), 0x780);
+    EXPECT_EQ(bus.read(0x077F), 0xC9);
+    EXPECT_EQ(bus.read(0x0780), MemoryBus::Open_Bus_Value);
+    EXPECT_EQ(bus.read(0x0800), MemoryBus::Open_Bus_Value);
+}
+
+TEST_F(SpaceInvadersMachineTest, RamOverlappingRomThrows) {
+    writeRoms();
+
+    const std::array<Fake8080::RamRange, 1> ranges{ { { 0x1000, 0x2FFF } } };
+
+    EXPECT_THROW((Fake8080{ pathViews, ranges }), std::invalid_argument);
+}
+
+TEST_F(SpaceInvadersMachineTest, WrongRomSizeThrows) {
+    writeRoms(Rom_Size / 2);
+
+    EXPECT_THROW(SpaceInvadersMachine{ pathViews }, std::invalid_argument);
+}
+
+// ==================== Tests de los puertos ====================
+
+TEST_F(SpaceInvadersMachineTest, ShiftRegisterReadsFromOffset) {
+    program[0x00] = 0x3E;  // MVI A, 0xAB
+    program[0x01] = 0xAB;
+    program[0x02] = 0xD3;  // OUT 4
+    program[0x03] = 0x04;
+    program[0x04] = 0x3E;  // MVI A, 0xCD
+    program[0x05] = 0xCD;
+    program[0x06] = 0xD3;  // OUT 4
+    program[0x07] = 0x04;
+    program[0x08] = 0x3E;  // MVI A, 3
+    program[0x09] = 0x03;
+    program[0x0A] = 0xD3;  // OUT 2
+    program[0x0B] = 0x02;
+    program[0x0C] = 0xDB;  // IN 3
+    program[0x0D] = 0x03;
+    program[0x0E] = 0x32;  // STA 0x2000
+    program[0x0F] = 0x00;
+    program[0x10] = 0x20;
+    program[0x11] = 0x76;  // HLT
+    writeRoms();
+
+    SpaceInvadersMachine machine{ pathViews };
+    machine.runFrame();
+
+    // El registro vale 0xCDAB y con desplazamiento 3 se leen sus bits 12 a 5
+    EXPECT_EQ(machine.cpu().memoryBus().read(0x2000), static_cast<uint8_t>(0xCDAB >> 5));
+}
+
+TEST_F(SpaceInvadersMachineTest, InputsAndDipSwitches) {
+    program[0x00] = 0xDB;  // IN 0
+    program[0x01] = 0x00;
+    program[0x02] = 0x32;  // STA 0x2000
+    program[0x03] = 0x00;
+    program[0x04] = 0x20;
+    program[0x05] = 0xDB;  // IN 1
+    program[0x06] = 0x01;
+    program[0x07] = 0x32;  // STA 0x2001
+    program[0x08] = 0x01;
+    program[0x09] = 0x20;
+    program[0x0A] = 0xDB;  // IN 2
+    program[0x0B] = 0x02;
+    program[0x0C] = 0x32;  // STA 0x2002
+    program[0x0D] = 0x02;
+    program[0x0E] = 0x20;
+    program[0x0F] = 0x76;  // HLT
+    writeRoms();
+
+    SpaceInvadersMachine machine{ pathViews };
+    machine.setInput(SpaceInvadersMachine::Input::Coin, true);
+    machine.setInput(SpaceInvadersMachine::Input::Player1Fire, true);
+    machine.setInput(SpaceInvadersMachine::Input::Player1Left, true);
+    machine.setInput(SpaceInvadersMachine::Input::Player1Left, false);
+    machine.setInput(SpaceInvadersMachine::Input::Player2Right, true);
+    machine.setDipSwitches(0xFF);
+    machine.runFrame();
+
+    auto& bus{ machine.cpu().memoryBus() };
+    EXPECT_EQ(bus.read(0x2000), 0b0000'1110);
+    EXPECT_EQ(bus.read(0x2001), 0b0001'1001);
+    EXPECT_EQ(bus.read(0x2002), 0b1100'1011);
+}
+
+// ==================== Tests de las interrupciones ====================
+
+TEST_F(SpaceInvadersMachineTest, FrameRaisesMidScreenAndVBlankInterrupts) {
+    const std::vector<uint8_t> main{
+        0x31, 0x00, 0x24,   // 0000: LXI SP, 0x2400
+        0xFB,               // 0003: EI
+        0xC3, 0x04, 0x00,   // 0004: JMP 0x0004
+        0x00,
+        0xC3, 0x20, 0x00,   // 0008: RST 1 -> JMP 0x0020
+        0x00, 0x00, 0x00, 0x00, 0x00,
+        0xC3, 0x30, 0x00,   // 0010: RST 2 -> JMP 0x0030
+    };
+
+    // Cada rutina incrementa su contador y apunta en 0x2002 qué interrupción llegó la última
+    const std::vector<uint8_t> handler{
+        0xF5,               // PUSH PSW
+        0x3A, 0x00, 0x20,   // LDA contador
+        0x3C,               // INR A
+        0x32, 0x00, 0x20,   // STA contador
+        0x3E, 0x00,         // MVI A, vector
+        0x32, 0x02, 0x20,   // STA 0x2002
+        0xF1,               // POP PSW
+        0xFB,               // EI
+        0xC9,               // RET
+    };
+
+    std::copy(main.begin(), main.end(), program.begin());
+
+    for (const uint8_t vector : { 1, 2 }) {
+        const size_t start{ vector == 1 ? 0x20u : 0x30u };
+        std::copy(handler.begin(), handler.end(), program.begin() + start);
+        program[start + 2] = static_cast<uint8_t>(vector - 1);
+        program[start + 6] = static_cast<uint8_t>(vector - 1);
+        program[start + 9] = vector;
+    }
+    writeRoms();
+
+    SpaceInvadersMachine machine{ pathViews };
+    auto& bus{ machine.cpu().memoryBus() };
+
+    // La interrupción del VBlank se solicita al final del frame y se atiende al empezar el siguiente
+    machine.runFrame();
+    EXPECT_EQ(machine.getFrames(), 1);
+    EXPECT_EQ(bus.read(0x2000), 1);
+    EXPECT_EQ(bus.read(0x2001), 0);
+    EXPECT_GE(machine.cpu().getCycles(), SpaceInvadersMachine::Cycles_Per_Frame);
+
+    machine.runFrame();
+    machine.runFrame();
+
+    EXPECT_EQ(machine.getFrames(), 3);
+    EXPECT_EQ(bus.read(0x2000), 3);
+    EXPECT_EQ(bus.read(0x2001), 2);
+    EXPECT_EQ(bus.read(0x2002), 1);
+}
@@ -38,8 +38,8 @@ TEST_F(XTHL_Test, XTHL_BasicExchange) {
     EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::L), 0xAB);
     
     // Verificar que el stack ahora tiene los valores originales de HL
-    EXPECT_EQ(cpu.rom_m[0xF000], 0x34);  // L original
-    EXPECT_EQ(cpu.rom_m[0xF001], 0x12);  // H original
+    EXPECT_EQ(cpu.memory_m[0xF000], 0x34);  // L original
+    EXPECT_EQ(cpu.memory_m[0xF001], 0x12);  // H original
     
     // Verificar SP no cambió
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::SP), 0xF000);
@@ -60,8 +60,8 @@ TEST_F(XTHL_Test, XTHL_ZeroValues) {
     uint8_t cycles = cpu.XTHL();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x0000);
-    EXPECT_EQ(cpu.rom_m[0xF000], 0x00);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0x00);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0x00);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0x00);
     EXPECT_EQ(cycles, 18);
 }
 
@@ -77,8 +77,8 @@ TEST_F(XTHL_Test, XTHL_MaxValues) {
     uint8_t cycles = cpu.XTHL();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0xFFFF);
-    EXPECT_EQ(cpu.rom_m[0xF000], 0xFF);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0xFF);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0xFF);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0xFF);
     EXPECT_EQ(cycles, 18);
 }
 
@@ -93,8 +93,8 @@ TEST_F(XTHL_Test, XTHL_DifferentValues) {
     uint8_t cycles = cpu.XTHL();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x1234);
-    EXPECT_EQ(cpu.rom_m[0xF000], 0xCD);  // L original
-    EXPECT_EQ(cpu.rom_m[0xF001], 0xAB);  // H original
+    EXPECT_EQ(cpu.memory_m[0xF000], 0xCD);  // L original
+    EXPECT_EQ(cpu.memory_m[0xF001], 0xAB);  // H original
     EXPECT_EQ(cycles, 18);
 }
 
@@ -113,8 +113,8 @@ TEST_F(XTHL_Test, XTHL_ByteOrderVerification) {
     
     EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::L), 0xCC);  // L <- (SP)
     EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::H), 0xDD);  // H <- (SP+1)
-    EXPECT_EQ(cpu.rom_m[0xF000], 0xBB);  // (SP) <- L original
-    EXPECT_EQ(cpu.rom_m[0xF001], 0xAA);  // (SP+1) <- H original
+    EXPECT_EQ(cpu.memory_m[0xF000], 0xBB);  // (SP) <- L original
+    EXPECT_EQ(cpu.memory_m[0xF001], 0xAA);  // (SP+1) <- H original
 }
 
 TEST_F(XTHL_Test, XTHL_LittleEndianCorrect) {
@@ -218,8 +218,8 @@ TEST_F(XTHL_Test, XTHL_DoubleExchange_RoundTrip) {
     
     // Valores deben volver a sus posiciones originales
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), original_hl);
-    EXPECT_EQ(cpu.rom_m[0xF000], original_stack_low);
-    EXPECT_EQ(cpu.rom_m[0xF001], original_stack_high);
+    EXPECT_EQ(cpu.memory_m[0xF000], original_stack_low);
+    EXPECT_EQ(cpu.memory_m[0xF001], original_stack_high);
 }
 
 TEST_F(XTHL_Test, XTHL_AtLowMemory) {
@@ -237,8 +237,8 @@ TEST_F(XTHL_Test, XTHL_AtLowMemory) {
     cpu.XTHL();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x3412);
-    EXPECT_EQ(cpu.rom_m[0x0100], 0xCD);
-    EXPECT_EQ(cpu.rom_m[0x0101], 0xAB);
+    EXPECT_EQ(cpu.memory_m[0x0100], 0xCD);
+    EXPECT_EQ(cpu.memory_m[0x0101], 0xAB);
 }
 
 TEST_F(XTHL_Test, XTHL_AtHighMemory) {
@@ -256,8 +256,8 @@ TEST_F(XTHL_Test, XTHL_AtHighMemory) {
     cpu.XTHL();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0xCDAB);
-    EXPECT_EQ(cpu.rom_m[0xFFFE], 0x34);
-    EXPECT_EQ(cpu.rom_m[0xFFFF], 0x12);
+    EXPECT_EQ(cpu.memory_m[0xFFFE], 0x34);
+    EXPECT_EQ(cpu.memory_m[0xFFFF], 0x12);
 }
 
 // ==================== Tests de operaciones múltiples ====================
@@ -301,8 +301,8 @@ TEST_F(XTHL_Test, XTHL_AfterPUSH) {
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x1234);
     
     // El stack debería tener el valor original de HL
-    EXPECT_EQ(cpu.rom_m[0xEFFE], 0x78);  // L original
-    EXPECT_EQ(cpu.rom_m[0xEFFF], 0x56);  // H original
+    EXPECT_EQ(cpu.memory_m[0xEFFE], 0x78);  // L original
+    EXPECT_EQ(cpu.memory_m[0xEFFF], 0x56);  // H original
 }
 
 TEST_F(XTHL_Test, XTHL_BeforePOP) {
@@ -341,8 +341,8 @@ TEST_F(XTHL_Test, RealisticUseCase_TemporarySwap) {
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x3000);
     
     // Y 0x2000 está guardado en el stack
-    EXPECT_EQ(cpu.rom_m[0xF000], 0x00);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0x20);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0x00);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0x20);
 }
 
 TEST_F(XTHL_Test, RealisticUseCase_StackManipulation) {
@@ -364,8 +364,8 @@ TEST_F(XTHL_Test, RealisticUseCase_StackManipulation) {
     cpu.XTHL();
     
     // El stack debe tener el nuevo valor
-    EXPECT_EQ(cpu.rom_m[0xF000], 0x44);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0x33);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0x44);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0x33);
 }
 
 TEST_F(XTHL_Test, RealisticUseCase_SaveReturnAddress) {
@@ -383,8 +383,8 @@ TEST_F(XTHL_Test, RealisticUseCase_SaveReturnAddress) {
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x0100);
     
     // Stack tiene la nueva dirección
-    EXPECT_EQ(cpu.rom_m[0xF000], 0x50);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0x01);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0x50);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0x01);
 }
 
 // ==================== Tests de patrones de bits ====================
@@ -399,8 +399,8 @@ TEST_F(XTHL_Test, PatternTest_AlternatingBits) {
     cpu.XTHL();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x5555);
-    EXPECT_EQ(cpu.rom_m[0xF000], 0xAA);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0xAA);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0xAA);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0xAA);
 }
 
 TEST_F(XTHL_Test, PatternTest_SingleBitSet) {
@@ -414,8 +414,8 @@ TEST_F(XTHL_Test, PatternTest_SingleBitSet) {
     cpu.XTHL();
     
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x0080);
-    EXPECT_EQ(cpu.rom_m[0xF000], 0x01);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0x00);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0x01);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0x00);
 }
 
 // ==================== Tests de condiciones de frontera ====================
@@ -450,8 +450,8 @@ TEST_F(XTHL_Test, BoundaryCondition_ByteValues) {
     
     EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::L), 0xFF);
     EXPECT_EQ(cpu.registers_m.getRegister(Registers::Register::H), 0x00);
-    EXPECT_EQ(cpu.rom_m[0xF000], 0x80);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0x7F);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0x80);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0x7F);
 }
 
 TEST_F(XTHL_Test, EdgeCase_ImmediateReuse) {
@@ -490,6 +490,6 @@ TEST_F(XTHL_Test, EdgeCase_ThreeWayRotation) {
     // HL <-> Stack: HL=0x1111, Stack=0x2222
     cpu.XTHL();
     EXPECT_EQ(cpu.registers_m.getCombinedRegister(Registers::CombinedRegister::HL), 0x1111);
-    EXPECT_EQ(cpu.rom_m[0xF000], 0x22);
-    EXPECT_EQ(cpu.rom_m[0xF001], 0x22);
+    EXPECT_EQ(cpu.memory_m[0xF000], 0x22);
+    EXPECT_EQ(cpu.memory_m[0xF001], 0x22);
 }
@@ -69,6 +69,24 @@ public:
     using CPU::POP_RR;
     using CPU::XTHL;
     using CPU::XCHG;
+    using CPU::OUT_d8;
+    using CPU::IN_d8;
+    using CPU::SPHL;
+    
+    // Exponer funciones de control de flujo
+    using CPU::NOP;
+    using CPU::JMP_a16;
+    using CPU::Jcc_a16;
+    using CPU::CALL_a16;
+    using CPU::Ccc_a16;
+    using CPU::RET;
+    using CPU::Rcc;
+    using CPU::PCHL;
+    using CPU::RST_n;
+    using CPU::DI;
+    using CPU::EI;
+    using CPU::HLT;
+    using CPU::conditionMet;
     
     // Exponer funciones de operaciones lógicas
     using CPU::ANA_R;
@@ -106,14 +124,115 @@ public:
     // Exponer función MOV R,M
     using CPU::MOV_R_M;
     
+    // Exponer la tabla de despacho
+    using CPU::MemberFunction;
+    using CPU::Opcodes;
+    using CPU::InvalidOpcode;
+    
+    // Handlers plantilla esperados en la tabla de despacho
+    template<Registers::Register Source, Registers::Register Destination>
+    static constexpr MemberFunction MOV_R_R_Handler{ &CPU::MOV_R_R<Source, Destination> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction MOV_R_M_Handler{ &CPU::MOV_R_M<R> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction MOV_M_R_Handler{ &CPU::MOV_M_R<R> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction MVI_R_d8_Handler{ &CPU::MVI_R_d8<R> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction INR_R_Handler{ &CPU::INR_R<R> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction DCR_R_Handler{ &CPU::DCR_R<R> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction ADD_R_Handler{ &CPU::ADD_R<R> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction SUB_R_Handler{ &CPU::SUB_R<R> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction XRA_R_Handler{ &CPU::XRA_R<R> };
+    
+    template<Registers::Register R>
+    static constexpr MemberFunction CMP_R_Handler{ &CPU::CMP_R<R> };
+    
+    template<Registers::CombinedRegister RR>
+    static constexpr MemberFunction LXI_RR_d16_Handler{ &CPU::LXI_RR_d16<RR> };
+    
+    template<Registers::CombinedRegister RR>
+    static constexpr MemberFunction INX_RR_Handler{ &CPU::INX_RR<RR> };
+    
+    template<Registers::CombinedRegister RR>
+    static constexpr MemberFunction DAD_RR_Handler{ &CPU::DAD_RR<RR> };
+    
+    template<Registers::CombinedRegister RR>
+    static constexpr MemberFunction PUSH_RR_Handler{ &CPU::PUSH_RR<RR> };
+    
+    template<Registers::CombinedRegister RR>
+    static constexpr MemberFunction POP_RR_Handler{ &CPU::POP_RR<RR> };
+    
+    template<uint8_t Condition>
+    static constexpr MemberFunction Jcc_a16_Handler{ &CPU::Jcc_a16<Condition> };
+    
+    template<uint8_t Condition>
+    static constexpr MemberFunction Ccc_a16_Handler{ &CPU::Ccc_a16<Condition> };
+    
+    template<uint8_t Condition>
+    static constexpr MemberFunction Rcc_Handler{ &CPU::Rcc<Condition> };
+    
+    template<uint8_t Vector>
+    static constexpr MemberFunction RST_n_Handler{ &CPU::RST_n<Vector> };
+    
+    // Exponer la caché de instrucciones decodificadas
+    using CPU::Opcodes_Number;
+    using CPU::Opcodes_Length;
+    using CPU::Opcodes_Cycles;
+    using CPU::Invokers;
+    using CPU::decode;
+#if defined(FAKE8080_DISPATCH_DECODE_CACHE)
+    using CPU::decodeCache_m;
+#endif
+    
+    // Exponer la caché de bloques básicos
+    using CPU::Block_Terminators;
+    using CPU::translateBlock;
+#if defined(FAKE8080_DISPATCH_BLOCK_CACHE)
+    using CPU::blockCache_m;
+#endif
+#if defined(FAKE8080_JIT)
+    using CPU::jit_m;
+    using CPU::runNative;
+#endif
+    
+    // Exponer el programa traducido por fake8080_aot
+#if defined(FAKE8080_DISPATCH_AOT)
+    using CPU::programBlocks_m;
+#endif
+    
     // Exponer el enum AritmeticOperation
     using CPU::AritmeticOperation;
     
     // Acceso a registros para testing
     using CPU::registers_m;
     
-    // Acceso a ROM para testing
-    using CPU::rom_m;
+    // Acceso a la memoria para testing
+    using CPU::memory_m;
+    using CPU::ports_m;
+    
+    // Acceso al contador de programa para testing
+    using CPU::pc_m;
+    
+    // Acceso al estado de las interrupciones para testing
+    using CPU::interruptsEnabled_m;
+    using CPU::halted_m;
+    
+    // Acceso a las porciones de run y a los bucles de espera para testing
+    using CPU::runSlice;
+    using CPU::idleCycles_m;
 };
 
 #endif // CPU_TEST_HELPER_HPP
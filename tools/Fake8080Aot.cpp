@@ -0,0 +1,52 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "AotCompiler.hpp"
+
+// Uso: fake8080_aot <rom> <salida.cpp> <símbolo> [entrada...]
+// Sin entradas se parte del reset (0x0000) y de los vectores de RST que caigan dentro de la imagen
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::fprintf(stderr, "Uso: %s <rom> <salida.cpp> <símbolo> [entrada hexadecimal...]\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream romFile{ argv[1], std::ios::binary };
+
+    if (!romFile) {
+        std::fprintf(stderr, "No se puede abrir la ROM %s\n", argv[1]);
+        return 1;
+    }
+
+    const std::vector<uint8_t> rom{ std::istreambuf_iterator<char>{ romFile }, std::istreambuf_iterator<char>{} };
+
+    std::vector<uint16_t> entryPoints;
+
+    for (int i{ 4 }; i < argc; ++i) {
+        entryPoints.push_back(static_cast<uint16_t>(std::stoul(argv[i], nullptr, 16)));
+    }
+
+    if (entryPoints.empty()) {
+        for (uint16_t vector{ 0 }; vector <= 0x38; vector += 8) {
+            entryPoints.push_back(vector);
+        }
+    }
+
+    AotCompiler compiler{ rom };
+    compiler.analyze(entryPoints);
+
+    std::ofstream output{ argv[2] };
+
+    if (!output) {
+        std::fprintf(stderr, "No se puede escribir %s\n", argv[2]);
+        return 1;
+    }
+
+    compiler.emit(output, argv[3]);
+
+    std::printf("%s: %zu bloques traducidos\n", argv[2], compiler.blocks().size());
+    return 0;
+}